@@ -0,0 +1,72 @@
+#pragma once
+
+#ifndef _BLOCK_SEGMENTATION_H_
+#define _BLOCK_SEGMENTATION_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "Volume.h"
+
+/*****************************************************************/
+
+// Block-compressed segmentation file (segmentation.blocks), an alternative to
+// segmentation.lzma with random access. The volume is split into blocks of blockSize
+// voxels (smaller at the upper borders), each compressed on its own with LZ4, so any
+// sub-box can be read by decompressing only the blocks it intersects. Layout
+// (little-endian):
+//
+//   CBlockSegmentationHeader
+//   uint64[blockCount + 1] block offsets, in bytes from the start of the file
+//   the LZ4 blocks, in x-fastest order of the block grid
+//
+// Within a block, voxels are in x-fastest order as in the uncompressed segmentation.
+
+const char     BLOCK_SEGMENTATION_MAGIC[8] = { 'E', 'W', 'S', 'E', 'G', 'B', 'L', 'K' };
+const uint32_t BLOCK_SEGMENTATION_VERSION = 1;
+
+struct CBlockSegmentationHeader {
+  char     magic[8];
+  uint32_t version;
+  uint32_t voxelSize;        // bytes per segment ID
+  uint64_t dimensions[3];    // volume size in voxels
+  uint64_t blockSize[3];     // block size in voxels
+  uint64_t blockCount;
+};
+
+// Block-compresses an uncompressed segmentation of the given dimensions into buffer
+void writeBlockSegmentation(std::vector<unsigned char> &buffer, const CBufferView &segmentation, const vmml::Vector<3, int64_t> &dimensions, uint32_t voxelSize, const vmml::Vector<3, int64_t> &blockSize);
+
+/*****************************************************************/
+
+// Random access to a block segmentation in memory. Nothing is copied; the buffer has to
+// stay alive for as long as the reader is used. Read is safe to call concurrently.
+class CBlockSegmentationReader {
+private:
+  const unsigned char      * buffer_;
+  size_t                     length_;
+  CBlockSegmentationHeader   header_;
+  vmml::Vector<3, int64_t>   dimensions_;
+  vmml::Vector<3, int64_t>   blockSize_;
+  vmml::Vector<3, int64_t>   blockGrid_;    // blocks along each axis
+
+  uint64_t blockOffset(int64_t block) const;
+
+public:
+  // Checks header and block offsets; throws std::string if the buffer is not a valid
+  // block segmentation.
+  explicit CBlockSegmentationReader(const CBufferView &buffer);
+
+  static bool IsBlockSegmentation(const CBufferView &buffer);
+
+  const vmml::Vector<3, int64_t> & GetDimensions() const { return dimensions_; }
+  uint32_t GetVoxelSize() const { return header_.voxelSize; }
+
+  // Decompresses the voxels inside bounds (in volume coordinates, within the volume) into
+  // out, in x-fastest order of bounds. Throws std::string if a block is corrupt.
+  void Read(const vmml::AABB<int64_t> &bounds, unsigned char * out) const;
+};
+
+/*****************************************************************/
+#endif
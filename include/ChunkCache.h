@@ -0,0 +1,60 @@
+#pragma once
+
+#ifndef _CHUNK_CACHE_H_
+#define _CHUNK_CACHE_H_
+
+#include <cstdint>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "ChunkLoader.h"
+
+/*****************************************************************/
+
+// Keeps recently used chunks, with their fully constructed CVolume, resident within a
+// byte budget, so the neighbors of one center chunk are still loaded when they become
+// the center themselves. Chunks are shared by reference count: a chunk requested by
+// several threads at once is read and decompressed only once, and eviction only drops
+// chunks nobody is using. Chunks in use still count against the budget.
+class CChunkCache {
+private:
+  typedef std::shared_future<std::shared_ptr<const CChunk>> CChunkFuture;
+
+  struct CEntry {
+    CChunkFuture                      chunk;
+    std::list<std::string>::iterator  lru;
+    uint64_t                          id;
+    size_t                            bytes;   // 0 while loading
+  };
+
+  std::string                              root_;
+  size_t                                   budget_;
+  bool                                     palette_;
+  size_t                                   bytes_;
+  uint64_t                                 nextID_;
+  std::mutex                               mutex_;
+  std::unordered_map<std::string, CEntry>  entries_;
+  std::list<std::string>                   lru_;      // most recently used first
+
+  void evict();
+
+public:
+  // Chunk paths are relative to root. budget is the memory in bytes the cache may keep.
+  // With palette set, chunks are kept palette encoded (see CChunk).
+  CChunkCache(const std::string &root, size_t budget, bool palette = false);
+
+  CChunkCache(const CChunkCache &) = delete;
+  CChunkCache & operator=(const CChunkCache &) = delete;
+
+  // Throws std::string if the chunk cannot be loaded
+  std::shared_ptr<const CChunk> Get(const std::string &path);
+
+  size_t GetByteSize();
+};
+
+/*****************************************************************/
+#endif
@@ -0,0 +1,54 @@
+#pragma once
+
+#ifndef _CHUNK_LOADER_H_
+#define _CHUNK_LOADER_H_
+
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "Volume.h"
+
+/*****************************************************************/
+
+std::vector<unsigned char> readFile(const std::string &filename);
+
+// "path/to/chunk/" -> "chunk"
+std::string chunkName(const std::string &path);
+
+// physical_offset_min from the metadata of the chunk, without loading the chunk
+vmml::Vector<3, int64_t> readChunkOffset(const std::string &path);
+
+/*****************************************************************/
+
+// Chunk of a dataset in a local directory, laid out as in the bucket: metadata.json,
+// segmentation.bbox, segmentation.size and segmentation.blocks, segmentation.lzma or an
+// uncompressed segmentation, in that order of preference. The binary sidecar metadata.bin
+// (see MetadataReader.h) is read instead of metadata.json if present. An optional segmentation.ids
+// makes the segment metadata sparse (see CVolumeMetadata). Owns the file contents the
+// volume is constructed from; a compressed segmentation is decoded into the volume itself.
+// With palette set, the volume is palette encoded once loaded and the dense segmentation
+// dropped, unless it has 64-bit segment IDs.
+class CChunk {
+private:
+  std::string                 metadata_;
+  std::vector<unsigned char>  ids_;
+  std::vector<unsigned char>  bboxes_;
+  std::vector<unsigned char>  sizes_;
+  std::vector<unsigned char>  segmentation_;
+  std::unique_ptr<CVolume>    volume_;
+
+public:
+  explicit CChunk(const std::string &path, bool palette = false);
+
+  CChunk(const CChunk &) = delete;
+  CChunk & operator=(const CChunk &) = delete;
+
+  const CVolume & GetVolume() const { return *volume_; }
+
+  // Approximate memory held by the chunk: file contents plus per-segment metadata
+  size_t GetByteSize() const;
+};
+
+/*****************************************************************/
+#endif
@@ -0,0 +1,183 @@
+#pragma once
+
+#ifndef _FLAT_SPAWN_TABLE_H_
+#define _FLAT_SPAWN_TABLE_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace ew { namespace spawner { class SpawnTable; } }
+
+/*****************************************************************/
+
+// Flat spawn table file (.flat.spawn), an alternative to the protobuf SpawnTable that
+// can be used in place, e.g. straight from mmap. Layout (little-endian):
+//
+//   CFlatSpawnTableHeader
+//   one array per FlatSpawnTableSection, each starting at a multiple of 8 bytes
+//
+// Segment IDs are sorted, lists are stored as CSR (offsets with count + 1 entries,
+// then values). Overlap size and pre-side supports of a post-side segment are stored
+// once, not repeated for every pre-side segment it overlaps.
+// Version 2 files are identical, except that the segment ID sections (PreIDs, PostIDs,
+// SupportIDs, GraphIDs, GraphNeighbors) are uint64. They are only written for tables
+// with IDs above 2^32 - 1.
+//
+// Version 3 (packed) files keep PreIDs, PostIDs, PostOverlapSizes and GraphIDs as in
+// version 1, but store the lists as group varint streams (see GroupVarint.h), one list
+// per entry, and the offsets as byte offsets into the stream:
+//   CounterpartPosts  per pre-side segment: (post - previous post) << 1 | canSpawn
+//   SupportIDs        per post-side segment: support ID deltas, then intersection sizes
+//   GraphNeighbors    per graph node: deltas of the neighbors with greater IDs, the first
+//                     one from the node's own ID; nodes without such neighbors are left out
+// CounterpartCanSpawn and SupportSizes are empty. Every edge of the symmetric region
+// graph is stored once, with its lower segment ID. Streams are followed by
+// GROUP_VARINT_PADDING zero bytes. The counts in the header stay those of the unpacked
+// table, except graphCount and neighborCount, which count the stored nodes and edges.
+
+const char     FLAT_SPAWN_TABLE_MAGIC[8] = { 'E', 'W', 'S', 'P', 'A', 'W', 'N', 'F' };
+const uint32_t FLAT_SPAWN_TABLE_VERSION = 1;
+const uint32_t FLAT_SPAWN_TABLE_VERSION_64 = 2;
+const uint32_t FLAT_SPAWN_TABLE_VERSION_PACKED = 3;
+
+// Protobuf SpawnTable versions: version 2 tables may hold segment IDs above 2^32 - 1,
+// which version 1 readers would truncate. Version 3 tables store every post-side
+// segment once in SpawnTable.postSegments (see res/spawnset.proto) and may hold IDs of
+// any width.
+const uint32_t SPAWN_TABLE_VERSION = 1;
+const uint32_t SPAWN_TABLE_VERSION_64 = 2;
+const uint32_t SPAWN_TABLE_VERSION_SHARED = 3;
+
+enum FlatSpawnTableSection {
+  PreIDs,                 // uint32[preCount]
+  PreOffsets,             // uint32[preCount + 1], into Counterpart*
+  CounterpartPosts,       // uint32[counterpartCount], index into PostIDs
+  CounterpartCanSpawn,    // uint8[counterpartCount]
+  PostIDs,                // uint32[postCount]
+  PostOverlapSizes,       // uint32[postCount]
+  PostOffsets,            // uint32[postCount + 1], into Support*
+  SupportIDs,             // uint32[supportCount], pre-side segment IDs
+  SupportSizes,           // uint32[supportCount], intersection sizes
+  GraphIDs,               // uint32[graphCount], post-side segment IDs
+  GraphOffsets,           // uint32[graphCount + 1], into GraphNeighbors
+  GraphNeighbors,         // uint32[neighborCount], post-side segment IDs
+  SectionCount
+};
+
+struct CFlatSpawnTableHeader {
+  char     magic[8];
+  uint32_t version;
+  uint32_t reserved;
+  uint64_t preCount;
+  uint64_t counterpartCount;
+  uint64_t postCount;
+  uint64_t supportCount;
+  uint64_t graphCount;
+  uint64_t neighborCount;
+  uint64_t sectionOffsets[SectionCount];   // byte offsets from the start of the file
+};
+
+/*****************************************************************/
+
+// Spawn table arrays as they are laid out in the flat file, owned. Segment IDs are held
+// as uint64 and narrowed on output when they fit into 32 bits.
+struct CFlatSpawnTableData {
+  std::vector<uint64_t> preIDs;
+  std::vector<uint32_t> preOffsets;
+  std::vector<uint32_t> counterpartPosts;
+  std::vector<uint8_t>  counterpartCanSpawn;
+  std::vector<uint64_t> postIDs;
+  std::vector<uint32_t> postOverlapSizes;
+  std::vector<uint32_t> postOffsets;
+  std::vector<uint64_t> supportIDs;
+  std::vector<uint32_t> supportSizes;
+  std::vector<uint64_t> graphIDs;
+  std::vector<uint32_t> graphOffsets;
+  std::vector<uint64_t> graphNeighbors;
+
+  CFlatSpawnTableData() : preOffsets(1, 0), postOffsets(1, 0), graphOffsets(1, 0) {}
+
+  // True if any segment ID needs more than 32 bits. Such tables are written as flat
+  // version 2 and protobuf version 2, all others as version 1.
+  bool HasWideIDs() const;
+
+  // True if the table can be written as flat version 3: 32-bit IDs, counterpart and
+  // support lists sorted, and a symmetric region graph with sorted neighbor lists,
+  // as calcSpawnTable produces them.
+  bool CanPack() const;
+
+  // Flat version 3 if packed and CanPack(), version 1 or 2 otherwise
+  void Write(std::vector<unsigned char> & buffer, bool packed = true) const;
+
+  // Conversion from and to the protobuf SpawnTable. Any version is read; version 1 or 2
+  // is written, version 3 if sharedPosts is set. Readers older than version 3 reject
+  // those tables, so they are opt-in.
+  void FromSpawnTable(const ew::spawner::SpawnTable & spawntable);
+  void ToSpawnTable(ew::spawner::SpawnTable & spawntable, bool sharedPosts = false) const;
+
+  // Serialized protobuf SpawnTable, byte for byte what deterministic serialization of
+  // ToSpawnTable gives, encoded straight from the arrays without building any messages.
+  void WriteSpawnTable(std::vector<unsigned char> & buffer, bool sharedPosts = false) const;
+};
+
+/*****************************************************************/
+
+// Spawn table arrays pointing into a flat file in memory. Nothing is copied; the
+// buffer has to stay alive and unchanged for as long as the view is used.
+// CFlatSpawnTableView reads version 1 and 3 (32-bit IDs) files, CFlatSpawnTableView64
+// version 2 files. For packed (version 3) files the list arrays are null and the
+// streams are set instead; the Get* functions read lists of either.
+template <typename ID>
+struct CFlatSpawnTableViewT {
+  bool             packed;
+  size_t           preCount;
+  size_t           counterpartCount;
+  size_t           postCount;
+  size_t           supportCount;
+  size_t           graphCount;
+  size_t           neighborCount;
+
+  const ID       * preIDs;
+  const uint32_t * preOffsets;
+  const uint32_t * counterpartPosts;
+  const uint8_t  * counterpartCanSpawn;
+  const ID       * postIDs;
+  const uint32_t * postOverlapSizes;
+  const uint32_t * postOffsets;
+  const ID       * supportIDs;
+  const uint32_t * supportSizes;
+  const ID       * graphIDs;
+  const uint32_t * graphOffsets;
+  const ID       * graphNeighbors;
+
+  const unsigned char * counterpartStream;
+  const unsigned char * supportStream;
+  const unsigned char * neighborStream;
+
+  CFlatSpawnTableViewT();
+
+  // Checks header, section bounds and CSR offsets; throws std::string if the buffer
+  // is not a valid flat spawn table of this ID width.
+  CFlatSpawnTableViewT(const unsigned char * buffer, size_t length);
+
+  static bool IsFlatSpawnTable(const unsigned char * buffer, size_t length);
+  // True for flat spawn tables with 64-bit IDs (version 2)
+  static bool HasWideIDs(const unsigned char * buffer, size_t length);
+
+  // Post-side counterparts (indices into postIDs) of a pre-side segment
+  void GetCounterparts(size_t pre, std::vector<uint32_t> & posts, std::vector<uint8_t> & canSpawn) const;
+  // Pre-side supports and their intersection sizes of a post-side segment
+  void GetSupports(size_t post, std::vector<ID> & ids, std::vector<uint32_t> & sizes) const;
+  // Neighbors of a region graph node; packed tables only hold those with greater IDs
+  void GetNeighbors(size_t graph, std::vector<ID> & neighbors) const;
+
+private:
+  void loadStreams(const unsigned char * buffer, size_t length);
+};
+
+typedef CFlatSpawnTableViewT<uint32_t> CFlatSpawnTableView;
+typedef CFlatSpawnTableViewT<uint64_t> CFlatSpawnTableView64;
+
+/*****************************************************************/
+#endif
@@ -0,0 +1,180 @@
+#pragma once
+
+#ifndef _GROUP_VARINT_H_
+#define _GROUP_VARINT_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// The SSSE3 decoder is compiled for its own target and chosen at run time, so builds
+// without -mssse3 have it as well
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define GROUP_VARINT_SSSE3 1
+#include <tmmintrin.h>
+#endif
+
+/*****************************************************************/
+
+// Group varint lists of uint32 values, as used by packed flat spawn tables.
+//
+// A list starts with its value count as LEB128 varint. The values follow in groups of
+// four: a control byte holding the byte length - 1 of each value (2 bits each, first
+// value in the lowest bits), then the values themselves, little endian, in 1 to 4 bytes.
+// The last group may hold fewer values. A whole group is decoded with one shuffle (SSSE3,
+// where the CPU has it) or four unaligned loads, both of which read up to 16 bytes past
+// the group; streams of lists have to be followed by GROUP_VARINT_PADDING readable bytes.
+
+const size_t GROUP_VARINT_PADDING = 16;
+
+inline void appendGroupVarintList(std::vector<unsigned char> & stream, const uint32_t * values, size_t count) {
+  uint64_t remaining = count;
+  while (remaining >= 0x80) {
+    stream.push_back(uint8_t(remaining) | 0x80);
+    remaining >>= 7;
+  }
+  stream.push_back(uint8_t(remaining));
+
+  for (size_t i = 0; i < count; i += 4) {
+    const size_t control = stream.size();
+    stream.push_back(0);
+    for (size_t j = 0; j < 4 && i + j < count; ++j) {
+      uint32_t value = values[i + j];
+      const uint8_t length = (value >> 24) ? 4 : (value >> 16) ? 3 : (value >> 8) ? 2 : 1;
+      stream[control] |= uint8_t((length - 1) << (2 * j));
+      for (uint8_t b = 0; b < length; ++b, value >>= 8) {
+        stream.push_back(uint8_t(value));
+      }
+    }
+  }
+}
+
+#if defined(GROUP_VARINT_SSSE3)
+// pshufb masks and data lengths of all 256 control bytes
+struct CGroupVarintShuffles {
+  uint8_t masks[256][16];
+  uint8_t lengths[256];
+
+  CGroupVarintShuffles() {
+    for (int control = 0; control < 256; ++control) {
+      uint8_t offset = 0;
+      for (int i = 0; i < 4; ++i) {
+        const uint8_t length = uint8_t(((control >> (2 * i)) & 3) + 1);
+        for (uint8_t b = 0; b < 4; ++b) {
+          masks[control][4 * i + b] = (b < length) ? uint8_t(offset + b) : 0x80;
+        }
+        offset += length;
+      }
+      lengths[control] = offset;
+    }
+  }
+};
+
+inline const CGroupVarintShuffles & groupVarintShuffles() {
+  static const CGroupVarintShuffles shuffles;
+  return shuffles;
+}
+#endif
+
+// Value count at the start of a list; checked against end if given
+inline const unsigned char * decodeGroupVarintCount(const unsigned char * p, uint64_t & count, const unsigned char * end) {
+  count = 0;
+  for (int shift = 0; ; shift += 7) {
+    if ((end && p >= end) || shift > 28) {
+      throw std::string("Group varint list is corrupt.");
+    }
+    const uint8_t byte = *p++;
+    count |= uint64_t(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) {
+      break;
+    }
+  }
+  // Every value takes at least one byte
+  if (end && count > uint64_t(end - p)) {
+    throw std::string("Group varint list is corrupt.");
+  }
+  return p;
+}
+
+// Groups of values i to count - 1
+inline const unsigned char * decodeGroupVarintGroups(const unsigned char * p, uint32_t * out, size_t i, size_t count, const unsigned char * end) {
+  static const uint32_t masks[4] = { 0xFFu, 0xFFFFu, 0xFFFFFFu, 0xFFFFFFFFu };
+
+  for (; i < count; i += 4) {
+    const uint8_t control = *p++;
+    const size_t groupCount = (count - i < 4) ? count - i : 4;
+    for (size_t j = 0; j < groupCount; ++j) {
+      const uint8_t length = uint8_t((control >> (2 * j)) & 3);
+      uint32_t value;
+      memcpy(&value, p, sizeof(value));
+      out[i + j] = value & masks[length];
+      p += length + 1;
+    }
+    if (end && p > end) {
+      throw std::string("Group varint list is corrupt.");
+    }
+  }
+  return p;
+}
+
+// Decodes the list at p into values and returns the position after it. With end given,
+// throws std::string if the list runs past end; without, the list is trusted.
+inline const unsigned char * decodeGroupVarintListScalar(const unsigned char * p, std::vector<uint32_t> & values, const unsigned char * end = nullptr) {
+  uint64_t count;
+  p = decodeGroupVarintCount(p, count, end);
+  values.resize(size_t(count));
+  return decodeGroupVarintGroups(p, values.data(), 0, values.size(), end);
+}
+
+#if defined(GROUP_VARINT_SSSE3)
+// Same as decodeGroupVarintListScalar, with full groups decoded by one shuffle each.
+// Only to be called if groupVarintHasSSSE3().
+__attribute__((target("ssse3")))
+inline const unsigned char * decodeGroupVarintListSSSE3(const unsigned char * p, std::vector<uint32_t> & values, const unsigned char * end = nullptr) {
+  uint64_t count;
+  p = decodeGroupVarintCount(p, count, end);
+  values.resize(size_t(count));
+  uint32_t * out = values.data();
+
+  const CGroupVarintShuffles & shuffles = groupVarintShuffles();
+  size_t i = 0;
+  for (; i + 4 <= values.size(); i += 4) {
+    const uint8_t control = *p++;
+    const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i *>(shuffles.masks[control]));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_shuffle_epi8(data, mask));
+    p += shuffles.lengths[control];
+    if (end && p > end) {
+      throw std::string("Group varint list is corrupt.");
+    }
+  }
+  return decodeGroupVarintGroups(p, out, i, values.size(), end);
+}
+
+inline bool groupVarintHasSSSE3() {
+  static const bool supported = []() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("ssse3") != 0;
+  }();
+  return supported;
+}
+#else
+inline bool groupVarintHasSSSE3() {
+  return false;
+}
+#endif
+
+// decodeGroupVarintListSSSE3 where the CPU supports it, decodeGroupVarintListScalar otherwise
+inline const unsigned char * decodeGroupVarintList(const unsigned char * p, std::vector<uint32_t> & values, const unsigned char * end = nullptr) {
+#if defined(GROUP_VARINT_SSSE3)
+  if (groupVarintHasSSSE3()) {
+    return decodeGroupVarintListSSSE3(p, values, end);
+  }
+#endif
+  return decodeGroupVarintListScalar(p, values, end);
+}
+
+/*****************************************************************/
+#endif
@@ -0,0 +1,33 @@
+#pragma once
+
+#ifndef _LZMA_H_
+#define _LZMA_H_
+
+#include <lzma.h>
+
+#include "Volume.h"
+
+/*****************************************************************/
+
+// Incremental decoder of LZMA alone data (segmentation.lzma). Each Read continues where
+// the previous one stopped, so a volume can be decoded slice by slice, and decoding can
+// stop before the end of the data.
+class CLZMADecoder {
+private:
+  lzma_stream stream_;
+  bool        ended_;
+
+public:
+  explicit CLZMADecoder(const CBufferView &compressed);
+  ~CLZMADecoder();
+
+  CLZMADecoder(const CLZMADecoder &) = delete;
+  CLZMADecoder & operator=(const CLZMADecoder &) = delete;
+
+  // Decodes the next length bytes into out. Returns fewer if the data ends before.
+  // Throws std::string if the data is corrupt.
+  size_t Read(unsigned char * out, size_t length);
+};
+
+/*****************************************************************/
+#endif
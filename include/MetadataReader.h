@@ -0,0 +1,49 @@
+#pragma once
+
+#ifndef _METADATA_READER_H_
+#define _METADATA_READER_H_
+
+#include <string>
+#include <vector>
+
+#include "Volume.h"
+
+/*****************************************************************/
+
+// The fields of a chunk's metadata.json the spawner uses, see CVolumeMetadata
+struct CMetadataFields {
+  vmml::Vector<3, int64_t> physicalOffsetMin;
+  vmml::Vector<3, int64_t> physicalOffsetMax;
+  vmml::Vector<3, int64_t> chunkVoxelDimensions;
+  vmml::Vector<3, int64_t> voxelResolution;
+  std::string              resolutionUnits;
+  MetaDataType             segmentIdType;
+  MetaDataType             boundingBoxType;
+  MetaDataType             sizeType;
+  int64_t                  numSegments;
+};
+
+/*****************************************************************/
+
+// Reads the fields from metadata.json in a single pass over the buffer, without building a
+// JSON document; other keys are skipped. Numbers with a fraction are truncated.
+// Throws std::string if a field is missing or malformed.
+void readMetadataJSON(const CBufferView &json, CMetadataFields &fields);
+
+// Binary sidecar of metadata.json (metadata.bin) for chunks that are loaded repeatedly,
+// little endian:
+//   char[4]   "SPMD"
+//   uint32    version (1)
+//   int64[12] physical_offset_min, physical_offset_max, chunk_voxel_dimensions, voxel_resolution
+//   int64     num_segments
+//   uint8[3]  segment_id_type, bounding_box_type, size_type (MetaDataType)
+//   uint8     length of resolution_units, followed by its characters
+bool isMetadataBinary(const CBufferView &buffer);
+void readMetadataBinary(const CBufferView &buffer, CMetadataFields &fields);
+void writeMetadataBinary(std::vector<unsigned char> &buffer, const CMetadataFields &fields);
+
+// readMetadataBinary if the buffer starts with the sidecar magic, readMetadataJSON otherwise
+void readMetadata(const CBufferView &buffer, CMetadataFields &fields);
+
+/*****************************************************************/
+#endif
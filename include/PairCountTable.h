@@ -0,0 +1,188 @@
+#pragma once
+
+#ifndef _PAIR_COUNT_TABLE_H_
+#define _PAIR_COUNT_TABLE_H_
+
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+
+/*****************************************************************/
+
+// (first, second) ID pair with its count, as extracted from CPairCountTableT.
+template <typename ID>
+struct CPairCountT {
+  ID       first;
+  ID       second;
+  uint32_t count;
+};
+
+template <typename ID>
+inline bool operator<(const CPairCountT<ID> &a, const CPairCountT<ID> &b) {
+  return a.first < b.first || (a.first == b.first && a.second < b.second);
+}
+
+typedef CPairCountT<uint32_t> CPairCount;
+typedef CPairCountT<uint64_t> CPairCount64;
+
+/*****************************************************************/
+
+// Key of an (first, second) ID pair in CPairCountTableT. Two 32-bit IDs share a single
+// 64-bit word; 64-bit IDs need a 128-bit key and a hash over both halves.
+template <typename ID>
+struct CPairKey;
+
+template <>
+struct CPairKey<uint32_t> {
+  typedef uint64_t Type;
+
+  static inline Type Pack(uint32_t first, uint32_t second) {
+    return (uint64_t(first) << 32) | second;
+  }
+  static inline uint32_t First(Type key) { return uint32_t(key >> 32); }
+  static inline uint32_t Second(Type key) { return uint32_t(key); }
+  static inline uint64_t Hash(Type key) { return key * 0x9E3779B97F4A7C15ull; }
+};
+
+template <>
+struct CPairKey<uint64_t> {
+  struct Type {
+    uint64_t first;
+    uint64_t second;
+
+    inline bool operator==(const Type &other) const { return first == other.first && second == other.second; }
+  };
+
+  static inline Type Pack(uint64_t first, uint64_t second) {
+    Type key = { first, second };
+    return key;
+  }
+  static inline uint64_t First(const Type &key) { return key.first; }
+  static inline uint64_t Second(const Type &key) { return key.second; }
+  static inline uint64_t Hash(const Type &key) { return (key.first * 0x9E3779B97F4A7C15ull + key.second) * 0x9E3779B97F4A7C15ull; }
+};
+
+/*****************************************************************/
+
+// Flat open-addressing hash table counting occurrences of (first, second) ID pairs.
+// The pair is packed into a single key (see CPairKey), so counting does not allocate
+// unless the table grows, and memory is bounded by the number of distinct pairs.
+template <typename ID>
+class CPairCountTableT {
+public:
+  typedef typename CPairKey<ID>::Type Key;
+
+private:
+  struct Slot {
+    Key      key;
+    uint32_t count;  // 0 marks an empty slot
+  };
+
+  std::vector<Slot> slots_;
+  uint64_t          mask_;
+  uint32_t          shift_;
+  size_t            size_;
+
+  inline uint64_t index(const Key &key) const {
+    return CPairKey<ID>::Hash(key) >> shift_;
+  }
+
+  void resize(size_t capacity) {
+    std::vector<Slot> old;
+    old.swap(slots_);
+    Slot empty = { Key(), 0 };
+    slots_.assign(capacity, empty);
+    mask_ = capacity - 1;
+    shift_ = 64;
+    for (size_t c = capacity; c > 1; c >>= 1) {
+      --shift_;
+    }
+    size_ = 0;
+    for (const Slot &slot : old) {
+      if (slot.count) {
+        Add(slot.key, slot.count);
+      }
+    }
+  }
+
+public:
+  explicit CPairCountTableT(size_t capacity = 1024) : size_(0) {
+    size_t pow2 = 16;
+    while (pow2 < capacity) {
+      pow2 <<= 1;
+    }
+    resize(pow2);
+  }
+
+  static inline Key Pack(ID first, ID second) {
+    return CPairKey<ID>::Pack(first, second);
+  }
+
+  // Key of an undirected pair, independent of the order of a and b.
+  static inline Key PackUnordered(ID a, ID b) {
+    return a < b ? Pack(a, b) : Pack(b, a);
+  }
+
+  inline void Add(const Key &key, uint32_t count = 1) {
+    uint64_t i = index(key);
+    for (;;) {
+      Slot &slot = slots_[i];
+      if (slot.count == 0) {
+        slot.key = key;
+        slot.count = count;
+        if (++size_ * 2 > slots_.size()) {
+          resize(slots_.size() * 2);
+        }
+        return;
+      }
+      if (slot.key == key) {
+        slot.count += count;
+        return;
+      }
+      i = (i + 1) & mask_;
+    }
+  }
+
+  inline void Add(ID first, ID second, uint32_t count = 1) {
+    Add(Pack(first, second), count);
+  }
+
+  void Merge(const CPairCountTableT &other) {
+    for (const Slot &slot : other.slots_) {
+      if (slot.count) {
+        Add(slot.key, slot.count);
+      }
+    }
+  }
+
+  // Empties the table but keeps its capacity for reuse.
+  void Clear() {
+    Slot empty = { Key(), 0 };
+    std::fill(slots_.begin(), slots_.end(), empty);
+    size_ = 0;
+  }
+
+  size_t Size() const {
+    return size_;
+  }
+
+  // All pairs, sorted by (first, second).
+  std::vector<CPairCountT<ID>> Sorted() const {
+    std::vector<CPairCountT<ID>> pairs;
+    pairs.reserve(size_);
+    for (const Slot &slot : slots_) {
+      if (slot.count) {
+        CPairCountT<ID> pair = { CPairKey<ID>::First(slot.key), CPairKey<ID>::Second(slot.key), slot.count };
+        pairs.push_back(pair);
+      }
+    }
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+  }
+};
+
+typedef CPairCountTableT<uint32_t> CPairCountTable;
+typedef CPairCountTableT<uint64_t> CPairCountTable64;
+
+/*****************************************************************/
+#endif
@@ -0,0 +1,99 @@
+#pragma once
+
+#ifndef _PALETTE_SEGMENTATION_H_
+#define _PALETTE_SEGMENTATION_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "Volume.h"
+
+/*****************************************************************/
+
+// Segmentation encoded like neuroglancer's compressed_segmentation: the volume is split
+// into blocks of BLOCK_SIZE^3 voxels (smaller at the upper borders), and each block
+// stores a sorted palette of its segment IDs plus one bit-packed palette index per voxel,
+// in x-fastest order. Blocks with a single segment store no indices at all, so
+// homogeneous regions cost a few bytes per block and can be handled block-wise.
+// Only bounds (in volume coordinates) is encoded; blocks are aligned to its minimum.
+class CPaletteSegmentation {
+public:
+  static const int64_t BLOCK_SIZE = 8;
+
+private:
+  struct CBlock {
+    uint64_t indexBegin;     // into indices_, in 64-bit words
+    uint32_t paletteBegin;   // into palette_
+    uint32_t bits;           // bits per index: 0 (single segment), 1, 2, 4, 8, 16 or 32
+  };
+
+  vmml::AABB<int64_t>       bounds_;
+  vmml::Vector<3, int64_t>  grid_;       // blocks along each axis
+  std::vector<CBlock>       blocks_;
+  std::vector<uint32_t>     palette_;
+  std::vector<uint64_t>     indices_;
+
+  void appendBlock(const std::vector<uint32_t> &values);
+
+  inline int64_t blockIndex(int64_t bx, int64_t by, int64_t bz) const {
+    return bx + by * grid_.x() + bz * grid_.x() * grid_.y();
+  }
+
+public:
+  template <typename T>
+  CPaletteSegmentation(const CSegmentationView<T> &segmentation, const vmml::AABB<int64_t> &bounds);
+
+  const vmml::AABB<int64_t> & GetBounds() const { return bounds_; }
+  size_t                      GetByteSize() const;
+
+  // Block containing voxel (x, y, z), per axis
+  inline vmml::Vector<3, int64_t> BlockOf(int64_t x, int64_t y, int64_t z) const {
+    return vmml::Vector<3, int64_t>((x - bounds_.getMin().x()) / BLOCK_SIZE, (y - bounds_.getMin().y()) / BLOCK_SIZE, (z - bounds_.getMin().z()) / BLOCK_SIZE);
+  }
+
+  // Voxels of block (bx, by, bz), in volume coordinates
+  vmml::AABB<int64_t> GetBlockBounds(int64_t bx, int64_t by, int64_t bz) const;
+
+  // True if the block holds a single segment, which is then stored in segID
+  inline bool IsUniform(int64_t bx, int64_t by, int64_t bz, uint32_t &segID) const {
+    const CBlock &block = blocks_[blockIndex(bx, by, bz)];
+    segID = palette_[block.paletteBegin];
+    return block.bits == 0;
+  }
+
+  uint32_t operator()(int64_t x, int64_t y, int64_t z) const;
+
+  // Decodes the length voxels starting at (x, y, z) along x into out
+  void DecodeRow(int64_t x, int64_t y, int64_t z, int64_t length, uint32_t * out) const;
+};
+
+/*****************************************************************/
+
+template <typename T>
+CPaletteSegmentation::CPaletteSegmentation(const CSegmentationView<T> &segmentation, const vmml::AABB<int64_t> &bounds) : bounds_(bounds) {
+  const vmml::Vector<3, int64_t> dims = bounds.getDimension();
+  for (int axis = 0; axis < 3; ++axis) {
+    grid_[axis] = (dims[axis] + BLOCK_SIZE - 1) / BLOCK_SIZE;
+  }
+  blocks_.reserve(size_t(grid_.x() * grid_.y() * grid_.z()));
+
+  std::vector<uint32_t> values;
+  for (int64_t bz = 0; bz < grid_.z(); ++bz) {
+    for (int64_t by = 0; by < grid_.y(); ++by) {
+      for (int64_t bx = 0; bx < grid_.x(); ++bx) {
+        const vmml::AABB<int64_t> block = GetBlockBounds(bx, by, bz);
+        values.clear();
+        for (int64_t z = block.getMin().z(); z < block.getMax().z(); ++z) {
+          for (int64_t y = block.getMin().y(); y < block.getMax().y(); ++y) {
+            const T * row = segmentation.Ptr(block.getMin().x(), y, z);
+            values.insert(values.end(), row, row + (block.getMax().x() - block.getMin().x()));
+          }
+        }
+        appendBlock(values);
+      }
+    }
+  }
+}
+
+/*****************************************************************/
+#endif
@@ -5,15 +5,16 @@
 
 #include "Volume.h"
 
-#include <zi/disjoint_sets/disjoint_sets.hpp>
 #include <zi/timer.hpp>
 
 #include <vmmlib/vmmlib.hpp>
 
 #include <unordered_map>
+#include <vector>
 #include <algorithm>
 #include <map>
 #include <set>
+#include <sstream>
 #include <cassert>
 
 /*****************************************************************/
@@ -111,7 +112,7 @@ enum class Direction {
 
 /*****************************************************************/
 
-Direction getDirection(const vmml::AABB<int64_t>& pre, const vmml::AABB<int64_t>& post) {
+inline Direction getDirection(const vmml::AABB<int64_t>& pre, const vmml::AABB<int64_t>& post) {
   vmml::AABB<int64_t> bounds = intersect(pre, post);
   assert(!bounds.isEmpty());
 
@@ -142,7 +143,7 @@ Direction getDirection(const vmml::AABB<int64_t>& pre, const vmml::AABB<int64_t>
 
 /*****************************************************************/
 
-int64_t getOverlap(const vmml::AABB<int64_t> &pre, const vmml::AABB<int64_t> &post, const Direction d) {
+inline int64_t getOverlap(const vmml::AABB<int64_t> &pre, const vmml::AABB<int64_t> &post, const Direction d) {
   vmml::AABB<int64_t> bounds = intersect(pre, post);
 
   switch (d) {
@@ -162,7 +163,7 @@ int64_t getOverlap(const vmml::AABB<int64_t> &pre, const vmml::AABB<int64_t> &po
 
 /*****************************************************************/
 
-vmml::AABB<int64_t> getOverlapRegion(const vmml::AABB<int64_t> &pre, const vmml::AABB<int64_t> &post, const Direction d, int64_t margin_pre, int64_t margin_post) {
+inline vmml::AABB<int64_t> getOverlapRegion(const vmml::AABB<int64_t> &pre, const vmml::AABB<int64_t> &post, const Direction d, int64_t margin_pre, int64_t margin_post) {
   vmml::AABB<int64_t> bounds = intersect(pre, post);
 
   // Trim on preside
@@ -212,12 +213,202 @@ inline bool inCriticalRegion(const vmml::Vector<3, int64_t> &pos, const vmml::AA
 
 /*****************************************************************/
 
+// Parts of pre and post, in volume coordinates, the overlap scans of calcSpawnTable and
+// get_seeds read: the overlap region less one voxel on either side. Loaders only need
+// to materialize these boxes; they are empty if the volumes do not overlap.
+inline void getOverlapVolumeROIs(const CVolumeMetadata &pre, const CVolumeMetadata &post, vmml::AABB<int64_t> &preVolumeROI, vmml::AABB<int64_t> &postVolumeROI) {
+  vmml::Vector<3, int64_t> res = pre.GetVoxelResolution();
+  vmml::AABB<int64_t> preBoundsWorld = vmml::divideVector(pre.GetPhysicalBounds(), res);
+  vmml::AABB<int64_t> postBoundsWorld = vmml::divideVector(post.GetPhysicalBounds(), res);
+
+  if (vmml::intersect(pre.GetPhysicalBounds(), post.GetPhysicalBounds()).isEmpty()) {
+    preVolumeROI = vmml::AABB<int64_t>(vmml::Vector<3, int64_t>(0, 0, 0), vmml::Vector<3, int64_t>(0, 0, 0));
+    postVolumeROI = preVolumeROI;
+    return;
+  }
+
+  Direction dir = getDirection(pre.GetPhysicalBounds(), post.GetPhysicalBounds());
+  vmml::AABB<int64_t> roiWorld = getOverlapRegion(preBoundsWorld, postBoundsWorld, dir, 1, 1);
+  preVolumeROI = vmml::subtractVector(roiWorld, preBoundsWorld.getMin());
+  postVolumeROI = vmml::subtractVector(roiWorld, postBoundsWorld.getMin());
+}
+
+/*****************************************************************/
+
+// Calls Kernel::run(preSegmentation, postSegmentation, args...) with the typed
+// segmentation views of pre and post, so the scan loops are instantiated once per
+// combination of segment ID types instead of going through CSegmentation per voxel.
+template <typename Kernel, typename TPre>
+struct CDispatchPost {
+  template <typename TPost, typename... Args>
+  static void run(const CSegmentationView<TPost> &postSegmentation, const CSegmentationView<TPre> &preSegmentation, Args&&... args) {
+    Kernel::run(preSegmentation, postSegmentation, std::forward<Args>(args)...);
+  }
+};
+
+template <typename Kernel>
+struct CDispatchPre {
+  template <typename TPre, typename... Args>
+  static void run(const CSegmentationView<TPre> &preSegmentation, const CVolume &post, Args&&... args) {
+    post.Dispatch<CDispatchPost<Kernel, TPre>>(preSegmentation, std::forward<Args>(args)...);
+  }
+};
+
+template <typename Kernel, typename... Args>
+void dispatchSegmentations(const CVolume &pre, const CVolume &post, Args&&... args) {
+  pre.Dispatch<CDispatchPre<Kernel>>(post, std::forward<Args>(args)...);
+}
+
+/*****************************************************************/
+
+// Iterates over the maximal runs of a row in which both a[x] and b[x] stay constant.
+// Segmentations are piecewise constant along x, so this replaces most per-voxel work
+// (hashing, set lookups) with per-run work.
+//   for (CRowRuns<TPre, TPost> run(preRow, postRow, length); run.Next(); ) { ... }
+template <typename TA, typename TB>
+class CRowRuns {
+private:
+  const TA * a_;
+  const TB * b_;
+  int64_t    length_;
+  int64_t    end_;
+
+public:
+  TA         first;      // a[x] within the run
+  TB         second;     // b[x] within the run
+  int64_t    begin;      // first x of the run
+  int64_t    runLength;
+
+  CRowRuns(const TA * a, const TB * b, int64_t length) : a_(a), b_(b), length_(length), end_(0), first(0), second(0), begin(0), runLength(0) {}
+
+  inline bool Next() {
+    if (end_ >= length_) {
+      return false;
+    }
+    begin = end_;
+    first = a_[begin];
+    second = b_[begin];
+    for (end_ = begin + 1; end_ < length_ && a_[end_] == first && b_[end_] == second; ++end_);
+    runLength = end_ - begin;
+    return true;
+  }
+};
+
+/*****************************************************************/
+
+// Connected-component labels over runs of selected voxels in a box, filled row by row
+// (rows ordered y-fastest, then z). Memory is proportional to the number of runs plus
+// one offset per row, not to the volume of the box.
+class CRowLabels {
+public:
+  struct Run {
+    int64_t x;
+    int64_t length;
+    bool    seed;     // bridge runs are always a single voxel
+  };
+
+private:
+  std::vector<Run>      runs_;
+  std::vector<uint32_t> parent_;
+  std::vector<uint32_t> rowStart_;
+  size_t                row_;
+
+  inline void join(uint32_t a, uint32_t b) {
+    a = Find(a);
+    b = Find(b);
+    if (a != b) {
+      parent_[std::max(a, b)] = std::min(a, b);
+    }
+  }
+
+public:
+  explicit CRowLabels(size_t rowCount) : rowStart_(rowCount + 1, 0), row_(0) {}
+
+  inline void BeginRow(size_t row) {
+    row_ = row;
+    rowStart_[row] = uint32_t(runs_.size());
+  }
+
+  inline void EndRow() {
+    rowStart_[row_ + 1] = uint32_t(runs_.size());
+  }
+
+  // Seed runs touching each other in a row are coalesced
+  inline void AddSeed(int64_t x, int64_t length) {
+    if (runs_.size() > rowStart_[row_] && runs_.back().seed && runs_.back().x + runs_.back().length == x) {
+      runs_.back().length += length;
+      return;
+    }
+    push(x, length, true);
+  }
+
+  inline void AddBridge(int64_t x) {
+    push(x, 1, false);
+  }
+
+  // Seed runs join a bridge voxel directly to their left
+  void JoinWithinRow(size_t row) {
+    for (uint32_t r = RowBegin(row) + 1; r < RowEnd(row); ++r) {
+      if (runs_[r].seed && !runs_[r - 1].seed && runs_[r - 1].x + 1 == runs_[r].x) {
+        join(r, r - 1);
+      }
+    }
+  }
+
+  // Seed runs of a row join every selected run of the neighbor row they overlap
+  void JoinRows(size_t row, size_t neighborRow) {
+    uint32_t n = RowBegin(neighborRow);
+    const uint32_t nEnd = RowEnd(neighborRow);
+    for (uint32_t r = RowBegin(row); r < RowEnd(row); ++r) {
+      const Run &run = runs_[r];
+      if (!run.seed) {
+        continue;
+      }
+      while (n < nEnd && runs_[n].x + runs_[n].length <= run.x) {
+        ++n;
+      }
+      for (uint32_t m = n; m < nEnd && runs_[m].x < run.x + run.length; ++m) {
+        join(r, m);
+      }
+    }
+  }
+
+  inline uint32_t Find(uint32_t r) {
+    while (parent_[r] != r) {
+      parent_[r] = parent_[parent_[r]];
+      r = parent_[r];
+    }
+    return r;
+  }
+
+  inline uint32_t RowBegin(size_t row) const {
+    return rowStart_[row];
+  }
+
+  inline uint32_t RowEnd(size_t row) const {
+    return rowStart_[row + 1];
+  }
+
+  inline const Run & GetRun(uint32_t r) const {
+    return runs_[r];
+  }
+
+private:
+  inline void push(int64_t x, int64_t length, bool seed) {
+    Run run = { x, length, seed };
+    parent_.push_back(uint32_t(runs_.size()));
+    runs_.push_back(run);
+  }
+};
+
+/*****************************************************************/
+
 
 // nkem, 10/19/2016: Previously (see date) this function selected all post-side segments with more than _half_ their volume matching the pre-side selected volume in the overlapping region.
 //                   If no segment fit that description, the single largest segment was chosen (largest being most voxels in the overlapping region)
 //                   The first part can now be controlled using matchRatio (0.5 for old behavior, 1.0 for exact matches),
 //                   and as fallback we choose a single segment, favorizing higher matchRatio as well as a minimum segment size. No exact science...
-std::map<uint32_t, uint32_t> makeSeed(const std::set<uint32_t>& bundle, const std::unordered_map<uint32_t, int> & mappingCounts, const std::unordered_map<uint32_t, int> & sizes, double matchRatio) {
+inline std::map<uint32_t, uint32_t> makeSeed(const std::set<uint32_t>& bundle, const std::unordered_map<uint32_t, int> & mappingCounts, const std::unordered_map<uint32_t, int> & sizes, double matchRatio) {
 
   std::map<uint32_t, uint32_t> ret;
   uint32_t bestCandidate = 0;
@@ -253,9 +444,9 @@ std::map<uint32_t, uint32_t> makeSeed(const std::set<uint32_t>& bundle, const st
 
 /*****************************************************************/
 
-bool is_valid_segment(uint32_t segID, const CVolume &segmentation) {
+inline bool is_valid_segment(uint64_t segID, const CVolume &segmentation) {
   // Check if segment ID is valid, and filter dust (by voxel size and dimensions)
-  return segID <= segmentation.GetSegmentMaxId() &&
+  return int64_t(segID) <= segmentation.GetSegmentMaxId() &&
          segID > 0 &&
          segmentation.GetSegmentSizeVoxel(segID) > 100 &&
          segmentation.GetSegmentBoundsVolume(segID).getDimension().find_min() > 1;
@@ -263,8 +454,192 @@ bool is_valid_segment(uint32_t segID, const CVolume &segmentation) {
 
 /*****************************************************************/
 
-void get_seeds(std::vector<std::map<uint32_t, uint32_t>> &seeds, const CVolume &pre, const std::set<uint32_t> &selected, const CVolume &post, double matchRatio) {
+// The user's selection compiled into a dense bitmap indexed by segment ID, two bits per segment:
+//   IsSelected: the segment was selected
+//   IsSeed:     the segment was selected and is a valid, non-dust segment (see is_valid_segment)
+// IDs above the volume's maximum segment ID are never selected. The bitmap ends at the
+// largest selected ID, so sparse ID spaces do not cost a bit pair per possible ID.
+class CSelectionBitmap {
+private:
+  std::vector<uint64_t> bits_;
+  uint64_t              count_;
+
+  inline uint64_t bits(uint64_t segID) const {
+    return segID < count_ ? bits_[segID >> 5] >> ((segID & 31) << 1) : 0;
+  }
+
+public:
+  CSelectionBitmap(const std::set<uint32_t> &selected, const CVolume &volume) :
+    count_(selected.empty() ? 0 : std::min<int64_t>(volume.GetSegmentMaxId(), *selected.rbegin()) + 1)
+  {
+    bits_.assign((count_ + 31) / 32, 0);
+    for (uint32_t segID : selected) {
+      if (segID == 0 || segID >= count_) {
+        continue;
+      }
+      uint64_t flags = is_valid_segment(segID, volume) ? 3 : 1;
+      bits_[segID >> 5] |= flags << ((segID & 31) << 1);
+    }
+  }
+
+  inline bool IsSelected(uint64_t segID) const {
+    return bits(segID) & 1;
+  }
+
+  inline bool IsSeed(uint64_t segID) const {
+    return bits(segID) & 2;
+  }
+};
+
+/*****************************************************************/
+
+// Voxel scans of get_seeds, templated on the segment ID types of pre and post.
+struct CSeedScan {
+  const CSelectionBitmap                           & selection;
+  vmml::AABB<int64_t>                                preVolumeROI;
+  vmml::AABB<int64_t>                                postVolumeROI;
+  vmml::AABB<int64_t>                                dilatedPostVolumeROI;
+  vmml::AABB<int64_t>                                roiWorld;
+  vmml::AABB<int64_t>                                preBoundsWorld;
+  Direction                                          dir;
+  int64_t                                            overlap;
+
+  std::unordered_map<uint32_t, int>                  mappingCounts;
+  std::unordered_map<uint32_t, int>                  sizes;
+  std::unordered_map<uint32_t, std::set<uint32_t>>   newSeedSets;
+  std::unordered_map<uint32_t, std::set<uint32_t>>   preSideSets;
+  std::unordered_map<uint32_t, bool>                 escapes;
+
+  CSeedScan(const CSelectionBitmap &selection_) : selection(selection_) {}
+
+  template <typename TPre, typename TPost>
+  static void run(const CSegmentationView<TPre> &preSegmentation, const CSegmentationView<TPost> &postSegmentation, CSeedScan &scan);
+};
+
+/*****************************************************************/
+
+template <typename TPre, typename TPost>
+void CSeedScan::run(const CSegmentationView<TPre> &preSegmentation, const CSegmentationView<TPost> &postSegmentation, CSeedScan &scan) {
+  zi::wall_timer t;
+  t.reset();
+
+  const CSelectionBitmap &selection = scan.selection;
+  const vmml::AABB<int64_t> &preVolumeROI = scan.preVolumeROI;
+  const vmml::AABB<int64_t> &postVolumeROI = scan.postVolumeROI;
+  const vmml::AABB<int64_t> &dilatedPostVolumeROI = scan.dilatedPostVolumeROI;
+
+  vmml::Vector<3, int64_t> dimROI = scan.roiWorld.getDimension();
+
+  std::unordered_map<uint32_t, int> &mappingCounts = scan.mappingCounts;
+  std::unordered_map<uint32_t, int> &sizes = scan.sizes;
+  std::set<uint32_t> postSelected;
+
+  // Connected components over runs instead of voxels: seed runs are maximal runs of
+  // seed voxels within a row, and every other selected voxel is a single-voxel bridge
+  // node. Seed voxels join their -x/-y/-z neighbors when those are selected, so bridges
+  // connect seed runs without being part of any seed set themselves.
+  CRowLabels labels(dimROI.y() * dimROI.z());
+
+  for (int64_t z = 0; z < dimROI.z(); ++z) {
+    for (int64_t y = 0; y < dimROI.y(); ++y) {
+      const TPre * preRow = preSegmentation.Ptr(preVolumeROI.getMin().x(), preVolumeROI.getMin().y() + y, preVolumeROI.getMin().z() + z);
+      const TPost * postRow = postSegmentation.Ptr(postVolumeROI.getMin().x(), postVolumeROI.getMin().y() + y, postVolumeROI.getMin().z() + z);
+      const size_t rowIndex = size_t(y + z * dimROI.y());
+
+      labels.BeginRow(rowIndex);
+      for (CRowRuns<TPre, TPost> run(preRow, postRow, dimROI.x()); run.Next(); ) {
+        if (selection.IsSeed(run.first)) {
+          uint32_t postSegID = run.second;
+          if (postSegID > 0) {
+            postSelected.insert(postSegID);
+            mappingCounts[postSegID] += int(run.runLength);
+          }
+          labels.AddSeed(run.begin, run.runLength);
+        } else if (selection.IsSelected(run.first)) {
+          for (int64_t x = run.begin; x < run.begin + run.runLength; ++x) {
+            labels.AddBridge(x);
+          }
+        }
+      }
+      labels.EndRow();
+
+      labels.JoinWithinRow(rowIndex);
+      if (y > 0) {
+        labels.JoinRows(rowIndex, rowIndex - 1);
+      }
+      if (z > 0) {
+        labels.JoinRows(rowIndex, rowIndex - size_t(dimROI.y()));
+      }
+    }
+  }
+
+  std::cout << "Connected Components + Finding Post Matches: " << t.elapsed<double>() << " s\n";
+  t.reset();
+
+
+  vmml::Vector<3, int64_t> dilatedPostROIDim(dilatedPostVolumeROI.getDimension());
+
+  for (int64_t z = 0; z < dilatedPostROIDim.z(); ++z) {
+    for (int64_t y = 0; y < dilatedPostROIDim.y(); ++y) {
+      const TPost * postRow = postSegmentation.Ptr(dilatedPostVolumeROI.getMin().x(), dilatedPostVolumeROI.getMin().y() + y, dilatedPostVolumeROI.getMin().z() + z);
+      for (int64_t x = 0, end = 0; x < dilatedPostROIDim.x(); x = end) {
+        uint32_t segID = postRow[x];
+        for (end = x + 1; end < dilatedPostROIDim.x() && postRow[end] == segID; ++end);
+
+        if (segID > 0 && postSelected.find(segID) != postSelected.end()) {
+          sizes[segID] += int(end - x);
+        }
+      }
+    }
+  }
+
+  std::cout << "Accumulate Post Segment Sizes: " << t.elapsed<double>() << " s\n";
+  t.reset();
+
+  for (int64_t z = 0; z < dimROI.z(); ++z) {
+    for (int64_t y = 0; y < dimROI.y(); ++y) {
+      const TPre * preRow = preSegmentation.Ptr(preVolumeROI.getMin().x(), preVolumeROI.getMin().y() + y, preVolumeROI.getMin().z() + z);
+      const TPost * postRow = postSegmentation.Ptr(postVolumeROI.getMin().x(), postVolumeROI.getMin().y() + y, postVolumeROI.getMin().z() + z);
+      const size_t rowIndex = size_t(y + z * dimROI.y());
+
+      for (uint32_t r = labels.RowBegin(rowIndex); r < labels.RowEnd(rowIndex); ++r) {
+        const CRowLabels::Run &seedRun = labels.GetRun(r);
+        if (!seedRun.seed) {
+          continue;
+        }
+
+        const uint32_t root = labels.Find(r);
+        std::set<uint32_t> &newSeedSet = scan.newSeedSets[root];
+        std::set<uint32_t> &preSideSet = scan.preSideSets[root];
+        for (CRowRuns<TPre, TPost> run(preRow + seedRun.x, postRow + seedRun.x, seedRun.length); run.Next(); ) {
+          preSideSet.insert(run.first);
+          newSeedSet.insert(run.second);
+        }
+
+        // The critical region is a slab along one axis, so checking both ends of the run suffices
+        const vmml::Vector<3, int64_t> first(seedRun.x, y, z);
+        const vmml::Vector<3, int64_t> last(seedRun.x + seedRun.length - 1, y, z);
+        bool &escape = scan.escapes[root];
+        if (!escape && (inCriticalRegion(first + scan.roiWorld.getMin(), scan.preBoundsWorld, scan.dir, scan.overlap/2) ||
+                        inCriticalRegion(last + scan.roiWorld.getMin(), scan.preBoundsWorld, scan.dir, scan.overlap/2))) {
+          escape = true;
+        }
+      }
+    }
+  }
+
+  std::cout << "Agglomeration of seed sets: " << t.elapsed<double>() << " s\n";
+}
+
+/*****************************************************************/
+
+// Selections and seeds carry 32-bit segment IDs; UInt64 segmentations are only supported
+// by the spawn table path (calcSpawnTable).
+inline void get_seeds(std::vector<std::map<uint32_t, uint32_t>> &seeds, const CVolume &pre, const std::set<uint32_t> &selected, const CVolume &post, double matchRatio) {
   seeds.clear();
+  if (pre.GetSegmentIdType() == MetaDataType::UInt64 || post.GetSegmentIdType() == MetaDataType::UInt64) {
+    throw(std::string("Seed extraction supports segment IDs of up to 32 bits."));
+  }
   zi::wall_timer t;
   t.reset();
 
@@ -305,11 +680,15 @@ void get_seeds(std::vector<std::map<uint32_t, uint32_t>> &seeds, const CVolume &
   vmml::AABB<int64_t> overlapWorld = getOverlapRegion(preBoundsWorld, postBoundsWorld, dir, 1, 1);
   vmml::AABB<int64_t> roiWorld = intersect(overlapWorld, segmentBoundsWorld);
 
-  vmml::AABB<int64_t> preVolumeROI = vmml::subtractVector(roiWorld, preBoundsWorld.getMin());
-  vmml::AABB<int64_t> postVolumeROI = vmml::subtractVector(roiWorld, postBoundsWorld.getMin());
+  CSelectionBitmap selection(selected, pre);
 
-  vmml::Vector<3, int64_t> dimROI = roiWorld.getDimension();
-  int64_t volumeROI = dimROI.x() * dimROI.y() * dimROI.z();
+  CSeedScan scan(selection);
+  scan.preVolumeROI = vmml::subtractVector(roiWorld, preBoundsWorld.getMin());
+  scan.postVolumeROI = vmml::subtractVector(roiWorld, postBoundsWorld.getMin());
+  scan.roiWorld = roiWorld;
+  scan.preBoundsWorld = preBoundsWorld;
+  scan.dir = dir;
+  scan.overlap = overlap;
 
   /*if (volumeROI > 400 * 128 * 128 * 128) {
     // Copied from old code... where does this restriction come from?
@@ -317,120 +696,20 @@ void get_seeds(std::vector<std::map<uint32_t, uint32_t>> &seeds, const CVolume &
     // TODO: Overlap region is too large. Log and throw some error.
   }*/
 
-  std::unordered_map<uint32_t, int> mappingCounts;
-  std::unordered_map<uint32_t, int> sizes;
-  zi::disjoint_sets<uint32_t> sets(volumeROI);
-  std::set<uint32_t> included, postSelected;
-
-  std::cout << "Initialization and sanity checks: " << t.elapsed<double>() << " s\n";
-  t.reset();
-
-
-  // TODO: Write an iterator for iterating through the given bounding box and skipping irrelevant segment IDs
-  vmml::Vector<3, int64_t> preROIPos(preVolumeROI.getMin());
-  vmml::Vector<3, int64_t> postROIPos(postVolumeROI.getMin());
-  const CSegmentation & preSegmentation = *(pre.GetSegmentation());
-  const CSegmentation & postSegmentation = *(post.GetSegmentation());
-  for (int64_t z = 0; z < dimROI.z(); ++z, ++preROIPos.z(), ++postROIPos.z()) {
-    preROIPos.y() = preVolumeROI.getMin().y();
-    postROIPos.y() = postVolumeROI.getMin().y();
-    for (int64_t y = 0; y < dimROI.y(); ++y, ++preROIPos.y(), ++postROIPos.y()) {
-      preROIPos.x() = preVolumeROI.getMin().x();
-      postROIPos.x() = postVolumeROI.getMin().x();
-      for (int64_t x = 0; x < dimROI.x(); ++x, ++preROIPos.x(), ++postROIPos.x()) {
-        uint32_t segID = preSegmentation(preROIPos);
-        //std::cout << segID << "\n";
-        if (is_valid_segment(segID, pre) && selected.find(segID) != selected.end()) {
-          uint32_t postSegID = postSegmentation(postROIPos);
-          if (postSegID > 0) {
-            postSelected.insert(postSegID);
-            mappingCounts[postSegID]++;
-          }
-
-          uint32_t proxy = x + y * dimROI.x() + z * dimROI.x() * dimROI.y();
-          included.insert(proxy);
-
-          // TODO: Store last (x-1) segID for possible speedup?
-          // TODO: Skip after first join?
-          if (x > 0) {
-            uint32_t neighborSegID = preSegmentation(preROIPos.x() - 1, preROIPos.y(), preROIPos.z());
-            if (neighborSegID > 0 && selected.find(neighborSegID) != selected.end()) {
-              uint32_t neighborProxy = (x - 1) + y * dimROI.x() + z * dimROI.x() * dimROI.y();
-              sets.join(sets.find_set(proxy), sets.find_set(neighborProxy));
-            }
-          }
-          if (y > 0) {
-            uint32_t neighborSegID = preSegmentation(preROIPos.x(), preROIPos.y() - 1, preROIPos.z());
-            if (neighborSegID > 0 && selected.find(neighborSegID) != selected.end()) {
-              uint32_t neighborProxy = x + (y - 1) * dimROI.x() + z * dimROI.x() * dimROI.y();
-              sets.join(sets.find_set(proxy), sets.find_set(neighborProxy));
-            }
-          }
-          if (z > 0) {
-            uint32_t neighborSegID = preSegmentation(preROIPos.x(), preROIPos.y(), preROIPos.z() - 1);
-            if (neighborSegID > 0 && selected.find(neighborSegID) != selected.end()) {
-              uint32_t neighborProxy = x + y * dimROI.x() + (z - 1) * dimROI.x() * dimROI.y();
-              sets.join(sets.find_set(proxy), sets.find_set(neighborProxy));
-            }
-          }
-        } // segID > 0 && selected.find(segID) != selected.end()
-      }
-    }
-  }
-
-  std::cout << "Connected Components + Finding Post Matches: " << t.elapsed<double>() << " s\n";
-  t.reset();
-
-
   const vmml::Vector<3, int64_t> EXPANSION(50,50,50);
-  vmml::AABB<int64_t> dilatedPostVolumeROI = vmml::dilate(postVolumeROI, EXPANSION);
-  dilatedPostVolumeROI = vmml::intersect(dilatedPostVolumeROI, vmml::subtractVector(overlapWorld, postBoundsWorld.getMin()));
-
-  vmml::Vector<3, int64_t> dilatedPostROIPos(dilatedPostVolumeROI.getMin());
-  vmml::Vector<3, int64_t> dilatedPostROIDim(dilatedPostVolumeROI.getDimension());
-
-  for (int64_t z = 0; z < dilatedPostROIDim.z(); ++z, ++dilatedPostROIPos.z()) {
-    dilatedPostROIPos.y() = dilatedPostVolumeROI.getMin().y();
-    for (int64_t y = 0; y < dilatedPostROIDim.y(); ++y, ++dilatedPostROIPos.y()) {
-      dilatedPostROIPos.x() = dilatedPostVolumeROI.getMin().x();
-      for (int64_t x = 0; x < dilatedPostROIDim.x(); ++x, ++dilatedPostROIPos.x()) {
-        uint32_t segID = postSegmentation(dilatedPostROIPos);
-
-        if (segID > 0 && postSelected.find(segID) != postSelected.end()) {
-          sizes[segID]++;
-        }
-      }
-    }
-  }
-
-  std::cout << "Accumulate Post Segment Sizes: " << t.elapsed<double>() << " s\n";
-  t.reset();
+  scan.dilatedPostVolumeROI = vmml::dilate(scan.postVolumeROI, EXPANSION);
+  scan.dilatedPostVolumeROI = vmml::intersect(scan.dilatedPostVolumeROI, vmml::subtractVector(overlapWorld, postBoundsWorld.getMin()));
 
-  std::unordered_map<uint32_t, std::set<uint32_t>> newSeedSets;
-  std::unordered_map<uint32_t, std::set<uint32_t>> preSideSets;
-  std::unordered_map<uint32_t, bool> escapes;
-  for (auto& i : included) {
-    escapes[sets.find_set(i)] = false;
-  }
-  for (auto& i : included) {
-    const vmml::Vector<3, int64_t> pos(i % dimROI.x(), (i / dimROI.x()) % dimROI.y(), i / (dimROI.x() * dimROI.y()));
-    const uint32_t root = sets.find_set(i);
-    newSeedSets[root].insert(postSegmentation(pos + postVolumeROI.getMin()));
-    preSideSets[root].insert(preSegmentation(pos + preVolumeROI.getMin()));
-    if (!escapes[root] && inCriticalRegion(pos + roiWorld.getMin(), preBoundsWorld, dir, overlap/2)) {
-      escapes[root] = true;
-    }
-  }
+  std::cout << "Initialization and sanity checks: " << t.elapsed<double>() << " s\n";
 
-  std::cout << "Agglomeration of seed sets: " << t.elapsed<double>() << " s\n";
-  t.reset();
+  dispatchSegmentations<CSeedScan>(pre, post, scan);
 
-  for (auto& seed : newSeedSets) {
-    if (escapes[seed.first]) {
-      seeds.push_back(makeSeed(seed.second, mappingCounts, sizes, matchRatio));
+  for (auto& seed : scan.newSeedSets) {
+    if (scan.escapes[seed.first]) {
+      seeds.push_back(makeSeed(seed.second, scan.mappingCounts, scan.sizes, matchRatio));
       std::cout << "\nSpawned: \n";
       std::cout << "  Pre Side: ";
-      for (auto& seg : preSideSets[seed.first]) {
+      for (auto& seg : scan.preSideSets[seed.first]) {
         std::cout << seg << ", ";
       }
       std::cout << "\n";
@@ -442,7 +721,7 @@ void get_seeds(std::vector<std::map<uint32_t, uint32_t>> &seeds, const CVolume &
       std::cout << "  Post Side: " << ss.str() << "\n";
     } else {
       std::cout << "\nDoes not escape: ";
-      for (auto& seg : preSideSets[seed.first]) {
+      for (auto& seg : scan.preSideSets[seed.first]) {
         std::cout << seg << ", ";
       }
       std::cout << "\n";
@@ -0,0 +1,57 @@
+#pragma once
+
+#ifndef _SPAWN_SET_GENERATOR_H_
+#define _SPAWN_SET_GENERATOR_H_
+
+#include <memory>
+#include <vector>
+
+#include "FlatSpawnTable.h"
+#include "Volume.h"
+
+class CThreadPool; // forward declaration, see ThreadPool.h
+
+/*****************************************************************/
+
+// State shared by many calcSpawnTable calls, e.g. of a worker process: the thread pool
+// the slab scans run on and the slab count tables, which keep their capacity between
+// calls. Checks the protobuf version once. Calls using one context must not overlap.
+class CSpawnContext {
+  friend void calcSpawnTable(CFlatSpawnTableData &spawntable, const CVolume &pre, const CVolume &post, CSpawnContext &context);
+
+private:
+  struct CScratch;
+
+  std::unique_ptr<CThreadPool> pool_;
+  std::unique_ptr<CScratch>    scratch_;
+
+public:
+  explicit CSpawnContext(unsigned int threadCount);
+  ~CSpawnContext();
+
+  CSpawnContext(const CSpawnContext &) = delete;
+  CSpawnContext & operator=(const CSpawnContext &) = delete;
+
+  unsigned int GetThreadCount() const;
+};
+
+/*****************************************************************/
+
+// Spawn table of pre towards the overlapping post volume. threadCount > 1 splits the
+// overlap ROI into z-slabs that are scanned in parallel. Pairs are counted with 32-bit
+// IDs unless either volume has UInt64 segment IDs.
+void calcSpawnTable(CFlatSpawnTableData &spawntable, const CVolume &pre, const CVolume &post, unsigned int threadCount = 1);
+// Same, with the slabs scanned on the context's threads
+void calcSpawnTable(CFlatSpawnTableData &spawntable, const CVolume &pre, const CVolume &post, CSpawnContext &context);
+
+// Spawn tables of a center volume towards each of its (up to six) face neighbors, with
+// the center loaded only once. Faces are processed concurrently; threadCount is shared
+// between them.
+void calcSpawnTables(std::vector<CFlatSpawnTableData> &spawntables, const CVolume &center, const std::vector<const CVolume *> &neighbors, unsigned int threadCount = 1);
+
+// Serialized protobuf SpawnTable (res/spawnset.proto), deterministic byte for byte.
+// Version 1 or 2; version 3 (post-side segments stored once) if sharedPosts is set.
+void serializeSpawnTable(const CFlatSpawnTableData &spawntable, std::vector<unsigned char> &buffer, bool sharedPosts = false);
+
+/*****************************************************************/
+#endif
@@ -0,0 +1,53 @@
+#pragma once
+
+#ifndef _SPAWN_TABLE_INDEX_H_
+#define _SPAWN_TABLE_INDEX_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <map>
+
+#include "FlatSpawnTable.h"
+
+/*****************************************************************/
+
+// Read-only, query-ready spawn table. Queries run directly on the flat layout (see
+// FlatSpawnTable.h): a flat file opened from disk is used in place via mmap, while a
+// protobuf SpawnTable is converted into a flat image once when loading, packed
+// (version 3) where possible. Tables with 64-bit IDs are held as flat version 2.
+class CSpawnTableIndex {
+private:
+  std::vector<unsigned char>  storage_;        // flat image, unless mapped_
+  void                      * mapped_;
+  size_t                      mappedLength_;
+  bool                        wide_;           // table64_ is used instead of table_
+  CFlatSpawnTableView         table_;
+  CFlatSpawnTableView64       table64_;
+
+  void view(const unsigned char * buffer, size_t length);
+  void load(const ew::spawner::SpawnTable & spawntable);
+  void load(const unsigned char * buffer, size_t length);
+
+public:
+  // Buffer with a flat or protobuf spawn table. The buffer is not referenced afterwards.
+  CSpawnTableIndex(const unsigned char * buffer, size_t length);
+  explicit CSpawnTableIndex(const ew::spawner::SpawnTable & spawntable);
+  // Flat or protobuf spawn table file. Flat files are mapped, not read.
+  explicit CSpawnTableIndex(const std::string & path);
+  ~CSpawnTableIndex();
+
+  CSpawnTableIndex(const CSpawnTableIndex &) = delete;
+  CSpawnTableIndex & operator=(const CSpawnTableIndex &) = delete;
+
+  // Same seeds as the spawn table lookup of the /get_seeds web handler: post-side
+  // counterparts of the selection, grouped by the region graph, filtered by
+  // matchRatio with a best-match fallback per group. The 32-bit query throws
+  // std::string if a seed holds an ID above 2^32 - 1.
+  void QuerySeeds(std::vector<std::map<uint32_t, uint32_t>> & seeds, const uint32_t * segments, size_t segmentCount, double matchRatio) const;
+  void QuerySeeds(std::vector<std::map<uint64_t, uint32_t>> & seeds, const uint64_t * segments, size_t segmentCount, double matchRatio) const;
+};
+
+/*****************************************************************/
+#endif
@@ -0,0 +1,73 @@
+#pragma once
+
+#ifndef _TASK_SPAWNER_H_
+#define _TASK_SPAWNER_H_
+
+#include <cstdint>
+#include <vector>
+#include <map>
+
+/*****************************************************************/
+
+// Seeds as returned through the C interfaces, one (segment ID -> size) map per seed.
+// CTaskSpawner64 carries 64-bit segment IDs; its Segment is 16 bytes with padding.
+template <typename ID>
+class CTaskSpawnerT {
+private:
+  struct Segment {
+    ID       id;
+    uint32_t size;
+  };
+
+  struct SpawnSeed {
+    uint32_t  segmentCount;
+    Segment  *segments;
+  };
+
+
+public:
+  uint32_t    spawnSetCount;
+  SpawnSeed  *seeds;
+
+  CTaskSpawnerT(const std::vector<std::map<ID, uint32_t>> & seeds_) {
+    spawnSetCount = seeds_.size();
+    if (spawnSetCount > 0) {
+      seeds = new SpawnSeed[spawnSetCount]; 
+      for (uint32_t i = 0; i < spawnSetCount; ++i) {
+        seeds[i].segmentCount = seeds_[i].size();
+        if (seeds[i].segmentCount) {
+          seeds[i].segments = new Segment[seeds[i].segmentCount];
+
+          uint32_t j = 0;
+          for (auto const &seedset : seeds_[i]) {
+            seeds[i].segments[j].id = seedset.first;
+            seeds[i].segments[j].size = seedset.second;
+            ++j;
+          }
+        } else {
+          seeds[i].segments = nullptr;
+        }
+      }
+    }
+    else {
+      seeds = nullptr;
+    }
+  }
+
+  ~CTaskSpawnerT() {
+    for (uint32_t i = 0; i < spawnSetCount; ++i) {
+      seeds[i].segmentCount = 0;
+      delete[] seeds[i].segments;
+      seeds[i].segments = nullptr;
+    }
+    spawnSetCount = 0;
+    delete[] seeds;
+    seeds = nullptr;
+  }
+};
+
+typedef CTaskSpawnerT<uint32_t> CTaskSpawner;
+typedef CTaskSpawnerT<uint64_t> CTaskSpawner64;
+
+/*****************************************************************/
+#endif
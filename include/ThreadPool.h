@@ -0,0 +1,59 @@
+#pragma once
+
+#ifndef _THREAD_POOL_H_
+#define _THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*****************************************************************/
+
+// Fixed set of worker threads with one task deque each. A worker runs its own tasks
+// newest first and, once its deque is empty, steals the oldest task of another worker,
+// so uneven tasks (e.g. chunks of very different density) do not leave threads idle.
+// Tasks must not throw.
+class CThreadPool {
+private:
+  struct CWorkerQueue {
+    std::mutex                         mutex;
+    std::deque<std::function<void()>>  tasks;
+  };
+
+  std::vector<std::unique_ptr<CWorkerQueue>>  queues_;
+  std::vector<std::thread>                    threads_;
+
+  std::mutex               mutex_;
+  std::condition_variable  wake_;     // tasks queued or stopping
+  std::condition_variable  done_;     // no tasks pending
+  std::atomic<size_t>      queued_;   // tasks waiting in any deque
+  std::atomic<size_t>      pending_;  // tasks queued or running
+  std::atomic<size_t>      nextQueue_;
+  bool                     stop_;
+
+  void work(size_t index);
+  bool pop(size_t index, std::function<void()> &task);
+  bool steal(size_t index, std::function<void()> &task);
+
+public:
+  explicit CThreadPool(unsigned int threadCount);
+  ~CThreadPool();
+
+  CThreadPool(const CThreadPool &) = delete;
+  CThreadPool & operator=(const CThreadPool &) = delete;
+
+  // Queues on the calling worker's own deque, or round-robin when called from outside
+  void Submit(std::function<void()> task);
+  // Blocks until all submitted tasks have finished
+  void Wait();
+
+  size_t GetThreadCount() const { return threads_.size(); }
+};
+
+/*****************************************************************/
+#endif
@@ -6,6 +6,7 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <utility>
 #include <vmmlib/vmmlib.hpp>
 
 /*****************************************************************/
@@ -15,6 +16,7 @@ enum class MetaDataType {
   UInt8,
   UInt16,
   UInt32,
+  UInt64,
   Float32,
   Float64
 };
@@ -22,6 +24,20 @@ enum class MetaDataType {
 /*****************************************************************/
 
 MetaDataType StringToMetaDataType(const std::string & str, uint8_t * sizeInByte = NULL);
+uint8_t      MetaDataTypeSize(MetaDataType type);
+
+/*****************************************************************/
+
+// Non-owning view on a caller-owned buffer. The caller has to keep the memory
+// alive for as long as any object constructed from the view is in use.
+struct CBufferView {
+  const unsigned char * data;
+  size_t                length;
+
+  CBufferView() : data(nullptr), length(0) {}
+  CBufferView(const unsigned char * data_, size_t length_) : data(data_), length(length_) {}
+  explicit CBufferView(const std::vector<unsigned char> & vec) : data(vec.data()), length(vec.size()) {}
+};
 
 /*****************************************************************/
 class CVolume; // forward declaration
@@ -32,13 +48,24 @@ class CVolumeMetadata {
 
 private:
 
+  // Per-segment voxel counts and volume bounds (min and max corner), decoded on demand
+  // from the size and bbox arrays in their own types; world bounds are derived from the
+  // volume bounds. Dense arrays are indexed by segment ID. Sparse arrays only hold the
+  // segments present, ids lists their IDs in ascending order and lookups binary search it.
   struct CSegments {
-    int64_t                          count;
-    std::vector<int64_t>             sizes;
-    std::vector<vmml::AABB<int64_t>> boundsVolume;
-    std::vector<vmml::AABB<int64_t>> boundsWorld;
-
-    CSegments(const CVolumeMetadata &meta, const std::vector<unsigned char> &raw_bboxes, const std::vector<unsigned char> &raw_sizes);
+    MetaDataType                     idType;
+    bool                             compacted; // arrays point into the owned ones
+    const unsigned char            * ids;       // nullptr if dense
+    const unsigned char            * sizes;
+    const unsigned char            * bboxes;
+    int64_t                          count;     // entries in sizes and bboxes
+    std::vector<unsigned char>       ownedIds;  // arrays compacted from dense ones, see CompactSegments
+    std::vector<unsigned char>       ownedSizes;
+    std::vector<unsigned char>       ownedBboxes;
+
+    CSegments(const CVolumeMetadata &meta, const CBufferView &raw_ids, const CBufferView &raw_bboxes, const CBufferView &raw_sizes);
+
+    int64_t Find(uint64_t segID) const;         // entry of segID, -1 if not listed
   };
 
   vmml::AABB<int64_t>        physical_offset;
@@ -49,13 +76,22 @@ private:
   MetaDataType               segment_bbox_type;
   MetaDataType               segment_size_type;
   uint8_t                    segment_id_type_size;
+  uint8_t                    segment_bbox_type_size;
+  uint8_t                    segment_size_type_size;
   int64_t                    segment_count;
   int64_t                    segment_max_id;
   CSegments                * segments;
 
 public:
 
+  // raw_json holds metadata.json or its binary sidecar, see MetadataReader.h.
+  // Construction only parses the metadata, segment sizes and bounds are decoded when queried.
+  // The ID, bbox and size buffers are borrowed, see CBufferView, unless OwnsSegmentArrays.
+  CVolumeMetadata(const CBufferView &raw_json, const CBufferView &raw_bboxes, const CBufferView &raw_sizes);
   CVolumeMetadata(const std::vector<unsigned char> &raw_json, const std::vector<unsigned char> &raw_bboxes, const std::vector<unsigned char> &raw_sizes);
+  // Sparse segment metadata: raw_ids lists the IDs of the segments present in ascending
+  // order, in segment_id_type, and raw_bboxes and raw_sizes hold one entry per listed ID.
+  CVolumeMetadata(const CBufferView &raw_json, const CBufferView &raw_ids, const CBufferView &raw_bboxes, const CBufferView &raw_sizes);
   ~CVolumeMetadata();
 
   const vmml::AABB<int64_t> &      GetPhysicalBounds() const;
@@ -65,7 +101,69 @@ public:
   uint8_t                          GetSegmentTypeSize() const;
   int64_t                          GetSegmentCount() const;
   int64_t                          GetSegmentMaxId() const;
+  int64_t                          GetSegmentSizeVoxel(uint64_t segID) const;
+  vmml::AABB<int64_t>              GetSegmentBoundsVolume(uint64_t segID) const;
+  vmml::AABB<int64_t>              GetSegmentBoundsWorld(uint64_t segID) const;
+  bool                             IsSparse() const;
+  // Copies the segments present out of dense arrays into sparse ones, if that takes less
+  // than half the memory. Walks every ID, meant for volumes that are kept around.
+  void                             CompactSegments();
+  // True once CompactSegments copied the arrays, the raw bbox and size buffers may be
+  // freed then. Otherwise they are borrowed.
+  bool                             OwnsSegmentArrays() const;
+  size_t                           GetByteSize() const;   // memory owned for the segment arrays
+
+};
+
+/*****************************************************************/
+
+// Non-virtual, typed access to a dense segmentation with precomputed strides.
+// Used by the voxel scan kernels, which walk raw rows instead of calling
+// CSegmentation::operator() per voxel.
+// The segmentation may hold only a sub-box of the volume; coordinates stay those of the
+// whole volume, and only voxels inside the box may be read.
+template <typename T>
+class CSegmentationView {
+private:
+  const T * segmentation_;
+  int64_t   strideY_;
+  int64_t   strideZ_;
+  int64_t   origin_;    // index the box minimum would have without the offset
 
+public:
+  typedef T value_type;
+
+  CSegmentationView(const vmml::Vector<3, int64_t> &dimensions, const T * segmentation) :
+    segmentation_(segmentation),
+    strideY_(dimensions.x()),
+    strideZ_(dimensions.x() * dimensions.y()),
+    origin_(0)
+  {
+  }
+
+  CSegmentationView(const vmml::AABB<int64_t> &box, const T * segmentation) :
+    segmentation_(segmentation),
+    strideY_(box.getDimension().x()),
+    strideZ_(box.getDimension().x() * box.getDimension().y()),
+    origin_(box.getMin().x() + box.getMin().y() * strideY_ + box.getMin().z() * strideZ_)
+  {
+  }
+
+  inline T operator()(int64_t x, int64_t y, int64_t z) const {
+    return segmentation_[x + y * strideY_ + z * strideZ_ - origin_];
+  }
+
+  inline T operator()(const vmml::Vector<3, int64_t> & pos) const {
+    return segmentation_[pos.x() + pos.y() * strideY_ + pos.z() * strideZ_ - origin_];
+  }
+
+  // Pointer to voxel (x, y, z). Consecutive x are adjacent in memory.
+  inline const T * Ptr(int64_t x, int64_t y, int64_t z) const {
+    return segmentation_ + (x + y * strideY_ + z * strideZ_ - origin_);
+  }
+
+  inline int64_t StrideY() const { return strideY_; }
+  inline int64_t StrideZ() const { return strideZ_; }
 };
 
 /*****************************************************************/
@@ -77,8 +175,10 @@ protected:
   CSegmentation(const vmml::Vector<3, int64_t> & dimensions);
 
 public:
-  virtual uint32_t operator()(int64_t x, int64_t y, int64_t z) const;
-  virtual uint32_t operator()(const vmml::Vector<3, int64_t> & pos) const;
+  virtual ~CSegmentation();
+
+  virtual uint64_t operator()(int64_t x, int64_t y, int64_t z) const;
+  virtual uint64_t operator()(const vmml::Vector<3, int64_t> & pos) const;
 
 };
 
@@ -86,33 +186,57 @@ public:
 
 class CSegmentationUChar : public CSegmentation {
 private:
-  const uint8_t * segmentation_;
+  const CSegmentationView<uint8_t> segmentation_;
 public:
-  CSegmentationUChar(const vmml::Vector<3, int64_t> &dimensions, const uint8_t * segmentation);
-  uint32_t operator()(int64_t x, int64_t y, int64_t z) const override;
-  uint32_t operator()(const vmml::Vector<3, int64_t> & pos) const override;
+  CSegmentationUChar(const vmml::Vector<3, int64_t> &dimensions, const CSegmentationView<uint8_t> &segmentation);
+  uint64_t operator()(int64_t x, int64_t y, int64_t z) const override;
+  uint64_t operator()(const vmml::Vector<3, int64_t> & pos) const override;
 };
 
 /*****************************************************************/
 
 class CSegmentationUShort : public CSegmentation {
 private:
-  const uint16_t * segmentation_;
+  const CSegmentationView<uint16_t> segmentation_;
 public:
-  CSegmentationUShort(const vmml::Vector<3, int64_t> &dimensions, const uint16_t * segmentation);
-  uint32_t operator()(int64_t x, int64_t y, int64_t z) const override;
-  uint32_t operator()(const vmml::Vector<3, int64_t> & pos) const override;
+  CSegmentationUShort(const vmml::Vector<3, int64_t> &dimensions, const CSegmentationView<uint16_t> &segmentation);
+  uint64_t operator()(int64_t x, int64_t y, int64_t z) const override;
+  uint64_t operator()(const vmml::Vector<3, int64_t> & pos) const override;
 };
 
 /*****************************************************************/
 
 class CSegmentationUInt : public CSegmentation {
 private:
-  const uint32_t * segmentation_;
+  const CSegmentationView<uint32_t> segmentation_;
+public:
+  CSegmentationUInt(const vmml::Vector<3, int64_t> &dimensions, const CSegmentationView<uint32_t> &segmentation);
+  uint64_t operator()(int64_t x, int64_t y, int64_t z) const override;
+  uint64_t operator()(const vmml::Vector<3, int64_t> & pos) const override;
+};
+
+/*****************************************************************/
+
+class CSegmentationULong : public CSegmentation {
+private:
+  const CSegmentationView<uint64_t> segmentation_;
+public:
+  CSegmentationULong(const vmml::Vector<3, int64_t> &dimensions, const CSegmentationView<uint64_t> &segmentation);
+  uint64_t operator()(int64_t x, int64_t y, int64_t z) const override;
+  uint64_t operator()(const vmml::Vector<3, int64_t> & pos) const override;
+};
+
+/*****************************************************************/
+
+class CPaletteSegmentation; // forward declaration, see PaletteSegmentation.h
+
+class CSegmentationPalette : public CSegmentation {
+private:
+  const CPaletteSegmentation & segmentation_;
 public:
-  CSegmentationUInt(const vmml::Vector<3, int64_t> &dimensions, const uint32_t * segmentation);
-  uint32_t operator()(int64_t x, int64_t y, int64_t z) const override;
-  uint32_t operator()(const vmml::Vector<3, int64_t> & pos) const override;
+  CSegmentationPalette(const vmml::Vector<3, int64_t> &dimensions, const CPaletteSegmentation &segmentation);
+  uint64_t operator()(int64_t x, int64_t y, int64_t z) const override;
+  uint64_t operator()(const vmml::Vector<3, int64_t> & pos) const override;
 };
 
 /*****************************************************************/
@@ -120,28 +244,89 @@ public:
 class CVolume {
   private:
 
-  static vmml::AABB<int64_t>       empty_bbox;
-
   std::unique_ptr<CVolumeMetadata> meta_;
 
+  std::vector<unsigned char>       owned_segmentation_;
+  const unsigned char            * raw_segmentation_;
+  vmml::AABB<int64_t>              resident_bounds_;     // part of the volume raw_segmentation_ holds
+  std::unique_ptr<CPaletteSegmentation> palette_;        // replaces raw_segmentation_ once set
   CSegmentation                  * segmentation_;
 
+  void                             readLZMA(const CBufferView &lzma_segmentation);
+  void                             readBlocks(const CBufferView &block_segmentation);
+  void                             createSegmentation();
 
   public:
+  CVolume(std::unique_ptr<CVolumeMetadata> &&meta, const CBufferView &raw_segmentation);
   CVolume(std::unique_ptr<CVolumeMetadata> &&meta, const std::vector<unsigned char> &raw_segmentation);
+  // Volume owning its segmentation, decoded from segmentation.lzma (LZMA alone data) or
+  // segmentation.blocks (BlockSegmentation.h). Only the voxels inside bounds (in volume
+  // coordinates, clamped to the volume) are kept; the segmentation of the rest of the
+  // volume must not be read. LZMA decoding stops after the last z-slice of bounds, block
+  // segmentations only decompress the blocks bounds intersects.
+  CVolume(std::unique_ptr<CVolumeMetadata> &&meta, const CBufferView &compressed_segmentation, const vmml::AABB<int64_t> &bounds);
   ~CVolume();
 
   const vmml::AABB<int64_t> &      GetPhysicalBounds() const;
   const vmml::Vector<3, int64_t> & GetVoxelResolution() const;
   int64_t                          GetSegmentCount() const;
   int64_t                          GetSegmentMaxId() const;
-  const vmml::AABB<int64_t> &      GetSegmentBoundsWorld(int64_t segID) const;
-  const vmml::AABB<int64_t> &      GetSegmentBoundsVolume(int64_t segID) const;
+  vmml::AABB<int64_t>              GetSegmentBoundsWorld(int64_t segID) const;
+  vmml::AABB<int64_t>              GetSegmentBoundsVolume(int64_t segID) const;
   int64_t                          GetSegmentSizeVoxel(int64_t segID) const;
+  MetaDataType                     GetSegmentIdType() const;
+  const CVolumeMetadata &          GetMetadata() const;
+  const vmml::AABB<int64_t> &      GetResidentBounds() const;
+  size_t                           GetSegmentationByteSize() const;
   const CSegmentation *            GetSegmentation() const;
 
+  // Re-encodes the resident segmentation as CPaletteSegmentation and drops the dense one;
+  // a borrowed buffer may be freed afterwards. Palette volumes are read through
+  // GetPaletteSegmentation or GetSegmentation; they have no dense view.
+  // Throws std::string for UInt64 segmentations, palettes hold 32-bit IDs.
+  void                             ConvertToPalette();
+  const CPaletteSegmentation *     GetPaletteSegmentation() const;   // nullptr if dense
+
+  template <typename T>
+  CSegmentationView<T>             GetSegmentationView() const;
+
+  // Calls Kernel::run(GetSegmentationView<T>(), args...) with T matching the segment ID type.
+  template <typename Kernel, typename... Args>
+  void                             Dispatch(Args&&... args) const;
 
 };
 
+/*****************************************************************/
+
+template <typename T>
+CSegmentationView<T> CVolume::GetSegmentationView() const {
+  return CSegmentationView<T>(resident_bounds_, reinterpret_cast<const T *>(raw_segmentation_));
+}
+
+/*****************************************************************/
+
+template <typename Kernel, typename... Args>
+void CVolume::Dispatch(Args&&... args) const {
+  if (palette_) {
+    throw(std::string("Palette encoded volumes have no dense segmentation view."));
+  }
+  switch (meta_->segment_id_type) {
+  case MetaDataType::UInt8:
+    Kernel::run(GetSegmentationView<uint8_t>(), std::forward<Args>(args)...);
+    break;
+  case MetaDataType::UInt16:
+    Kernel::run(GetSegmentationView<uint16_t>(), std::forward<Args>(args)...);
+    break;
+  case MetaDataType::UInt32:
+    Kernel::run(GetSegmentationView<uint32_t>(), std::forward<Args>(args)...);
+    break;
+  case MetaDataType::UInt64:
+    Kernel::run(GetSegmentationView<uint64_t>(), std::forward<Args>(args)...);
+    break;
+  default:
+    throw(std::string("Unsupported segment ID type."));
+  }
+}
+
 /*****************************************************************/
 #endif
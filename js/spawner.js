@@ -10,7 +10,6 @@ let send       = require('koa-send');
 let rp         = require('request-promise');
 let lzma       = require('lzma-native');     // one time decompression of segmentation
 let lz4        = require('lz4');             // (de)compression of segmentation from/to redis
-let protobuf   = require('protobufjs');
 
 let NodeRedis  = require('redis');           // cache for volume data (metadata, segment bboxes and sizes, segmentation)
 let redis = NodeRedis.createClient('6379', '127.0.0.1', {return_buffers: true});
@@ -21,6 +20,8 @@ Promise.promisifyAll(NodeRedis.Multi.prototype);
 // Typedefs
 let UCharPtr = ref.refType(ref.types.uchar);
 let UInt32Ptr = ref.refType(ref.types.uint32);
+let UInt64Ptr = ref.refType(ref.types.uint64);
+let VoidPtr = ref.refType(ref.types.void);
 
 let Segment = Struct({
     'id': ref.types.uint32,
@@ -37,6 +38,22 @@ let CTaskSpawner = Struct({
     'seeds': ref.refType(SpawnSeed)
 });
 
+// Same as Segment, SpawnSeed and CTaskSpawner, with 64-bit segment IDs
+let Segment64 = Struct({
+    'id': ref.types.uint64,
+    'size': ref.types.uint32
+});
+
+let SpawnSeed64 = Struct({
+    'segmentCount': ref.types.uint32,
+    'segments': ref.refType(Segment64)
+});
+
+let CTaskSpawner64 = Struct({
+    'spawnSetCount': ref.types.uint32,
+    'seeds': ref.refType(SpawnSeed64)
+});
+
 let CInputVolume = Struct({
     'metadata': "string",
     'bboxesLength': ref.types.uint32,
@@ -48,6 +65,7 @@ let CInputVolume = Struct({
 });
 
 let CTaskSpawnerPtr = ref.refType(CTaskSpawner);
+let CTaskSpawner64Ptr = ref.refType(CTaskSpawner64);
 let CInputVolumePtr = ref.refType(CInputVolume);
 
 let TaskSpawnerLib = ffi.Library('../lib/libspawner', {
@@ -58,20 +76,25 @@ let TaskSpawnerLib = ffi.Library('../lib/libspawner', {
     "TaskSpawner_Release": [ "void", [ CTaskSpawnerPtr ] ],
 });
 
-let SpawnTableDef;
-protobuf.load("../res/spawnset.proto").then(function(root) {
-    SpawnTableDef = root.lookupType("ew.spawner.SpawnTable");
-}).catch(function(err) {
-    console.log("Couldn't load protobuf definitions: " + err);
-});
+let SpawnTableIndexLib = ffi.Library('../lib/libspawntableindex', {
+    // CSpawnTableIndex * SpawnTableIndex_Load(const unsigned char * buffer, uint32_t length);
+    "SpawnTableIndex_Load": [ VoidPtr, [ UCharPtr, "uint32" ] ],
 
-function strMapToObj(strMap) {
-    const obj = Object.create(null);
-    for (const [key, val] of strMap) {
-        obj[key] = val;
-    }
-    return obj;
-}
+    // CTaskSpawner * SpawnTableIndex_QuerySeeds(const CSpawnTableIndex * index, const uint32_t * segments, uint32_t segmentCount, double matchRatio);
+    "SpawnTableIndex_QuerySeeds": [ CTaskSpawnerPtr, [ VoidPtr, UInt32Ptr, "uint32", "double" ] ],
+
+    // void SpawnTableIndex_ReleaseSeeds(CTaskSpawner * taskspawner);
+    "SpawnTableIndex_ReleaseSeeds": [ "void", [ CTaskSpawnerPtr ] ],
+
+    // CTaskSpawner64 * SpawnTableIndex_QuerySeeds64(const CSpawnTableIndex * index, const uint64_t * segments, uint32_t segmentCount, double matchRatio);
+    "SpawnTableIndex_QuerySeeds64": [ CTaskSpawner64Ptr, [ VoidPtr, UInt64Ptr, "uint32", "double" ] ],
+
+    // void SpawnTableIndex_ReleaseSeeds64(CTaskSpawner64 * taskspawner);
+    "SpawnTableIndex_ReleaseSeeds64": [ "void", [ CTaskSpawner64Ptr ] ],
+
+    // void SpawnTableIndex_Release(CSpawnTableIndex * index);
+    "SpawnTableIndex_Release": [ "void", [ VoidPtr ] ],
+});
 
 function validateMetadata(metadataString) { // Todo: more checks, better error handling
     try {
@@ -129,9 +152,7 @@ function validateMetadata(metadataString) { // Todo: more checks, better error h
 }
 
 function generateSpawnCandidates(pre, post, segments, matchRatio) {
-    let segmentsTA = new Uint32Array(segments);
-    let segmentsBuffer = Buffer.from(segmentsTA.buffer);
-    segmentsBuffer.type = ref.types.uint32;
+    let segmentsBuffer = segmentsToBuffer(segments);
 
     //console.log(pre);
 
@@ -155,12 +176,58 @@ function generateSpawnCandidates(pre, post, segments, matchRatio) {
           segmentation:        post.segmentation
         });
 
-    let spawnSets = TaskSpawnerLib.TaskSpawner_Spawn(pre_vol.ref(), post_vol.ref(), segmentsBuffer, segmentsTA.length, matchRatio);
+    let spawnSets = TaskSpawnerLib.TaskSpawner_Spawn(pre_vol.ref(), post_vol.ref(), segmentsBuffer, segments.length, matchRatio);
+    if (spawnSets.isNull()) {
+        throw new TypeError("Seed extraction failed, see the spawner log.");
+    }
 
     return spawnSets;
 }
 
 
+function segmentsToBuffer(segments) {
+    let segmentsTA = new Uint32Array(segments);
+    let segmentsBuffer = Buffer.from(segmentsTA.buffer);
+    segmentsBuffer.type = ref.types.uint32;
+    return segmentsBuffer;
+}
+
+function segmentsToBuffer64(segments) {
+    let segmentsBuffer = Buffer.alloc(segments.length * 8);
+    segments.forEach(function (segment, i) {
+        ref.writeUInt64LE(segmentsBuffer, i * 8, segment);
+    });
+    segmentsBuffer.type = ref.types.uint64;
+    return segmentsBuffer;
+}
+
+// Converts a CTaskSpawner into an array of { segID: size } objects, one per seed.
+// Pass SpawnSeed64 and Segment64 for a CTaskSpawner64.
+function readSpawnSets(taskSpawnerPtr, SpawnSeedType = SpawnSeed, SegmentType = Segment) {
+    let taskSpawner = taskSpawnerPtr.deref();
+    let result = [];
+
+    if (taskSpawner.spawnSetCount > 0) {
+        let spawnSetArray = taskSpawner.seeds.ref().readPointer(0, taskSpawner.spawnSetCount * SpawnSeedType.size);
+
+        for (let i = 0; i < taskSpawner.spawnSetCount; ++i) {
+            let spawnSet = ref.get(spawnSetArray, i * SpawnSeedType.size, SpawnSeedType);
+            if (spawnSet.segmentCount > 0) {
+                let segmentArray = spawnSet.segments.ref().readPointer(0, spawnSet.segmentCount * SegmentType.size);
+
+                let set = {}
+                for (let j = 0; j < spawnSet.segmentCount; ++j) {
+                    let segment = ref.get(segmentArray, j * SegmentType.size, SegmentType);
+                    set[segment.id] = segment.size;
+                }
+                result.push(set);
+            }
+        }
+    }
+
+    return result;
+}
+
 /* cachedFetch
 
  * Input: request-promise input, e.g. { url: path, encoding: null }
@@ -294,6 +361,56 @@ app.post('/get_segment_data', null, {
 
 });
 
+/* loadSpawnTableIndex
+
+ * Input: URL of a precomputed spawntable (protobuf .pb.spawn or flat .flat.spawn)
+ *
+ * Description: Spawntables stay resident as native indices, so repeated requests for the same
+ *              chunk pair neither download nor parse the table again. The least recently used
+ *              indices are released once more than SPAWN_TABLE_INDEX_CACHE_SIZE are loaded.
+ *
+ * Returns: Promise of the native index
+ */
+const SPAWN_TABLE_INDEX_CACHE_SIZE = 256;
+let spawnTableIndices = new Map();
+
+function loadSpawnTableIndex(spawntable_path) {
+    let index = spawnTableIndices.get(spawntable_path);
+    if (index) {
+        spawnTableIndices.delete(spawntable_path);
+        spawnTableIndices.set(spawntable_path, index);
+        return index;
+    }
+
+    console.time("loading " + spawntable_path);
+    index = cachedFetch({ url: spawntable_path, encoding: null }) // "encoding: null" is request's cryptic way of saying: binary
+        .then(function (buffer) {
+            const indexPtr = SpawnTableIndexLib.SpawnTableIndex_Load(buffer, buffer.length);
+            if (indexPtr.isNull()) {
+                throw new TypeError(`${spawntable_path} is not a valid spawntable.`);
+            }
+            console.timeEnd("loading " + spawntable_path);
+            return indexPtr;
+        });
+
+    index.catch(function () {
+        if (spawnTableIndices.get(spawntable_path) === index) {
+            spawnTableIndices.delete(spawntable_path);
+        }
+    });
+
+    spawnTableIndices.set(spawntable_path, index);
+    while (spawnTableIndices.size > SPAWN_TABLE_INDEX_CACHE_SIZE) {
+        const [oldestPath, oldestIndex] = spawnTableIndices.entries().next().value;
+        spawnTableIndices.delete(oldestPath);
+        oldestIndex.then(function (indexPtr) {
+            SpawnTableIndexLib.SpawnTableIndex_Release(indexPtr);
+        }).catch(function () {});
+    }
+
+    return index;
+}
+
 // get_seeds function that returns seed segments based on a precomputed spawntable. Very fast.
 app.post('/get_seeds', null, {
     bucket: { type: 'string' },
@@ -319,112 +436,17 @@ app.post('/get_seeds', null, {
     const spawntable_path = pre_segmentation_path + path_post.match(/([^\/]*)\/*$/)[1] + '.pb.spawn';
 
     console.time("get_seeds for " + spawntable_path);
-    console.time("loading " + spawntable_path);
-
-    const requests = [
-        { url: spawntable_path, encoding: null }, // "encoding: null" is request's cryptic way of saying: binary
-    ];
-
-    // Bluebird.map ensures order of responses equals order of requests
-    yield Promise.map(requests, function (request) {
-        console.log("Request: " + request.url);
-        return cachedFetch(request);
-    }).then(function(responses) {
-        console.timeEnd("loading " + spawntable_path);
-        console.time("parsing " + spawntable_path);
-        const spawnMapEnc = responses[0];
-        const spawnMapDec = SpawnTableDef.decode(spawnMapEnc);
-        const spawnMap = spawnMapDec.preSpawnMap;
-        const regionGraph = spawnMapDec.postRegionGraph;
-        const version = spawnMapDec.version || 0;
-        console.timeEnd("parsing " + spawntable_path);
-
-        if (version !== 1) {
-            throw(TypeError(`${spawntable_path} version is ${version}, but 1 expected!`));
-        }
-
-        // Retrieve post-side candidates for selection
-        const selection = new Set(segments);
-        const postCandidates = new Map();
-        for (const preKey of selection) {
-            if (spawnMap[preKey]) {
-                for (const postCandidate of spawnMap[preKey].postSideCounterparts) {
-                    if (postCandidates.has(postCandidate.id) === false) {
-                        postCandidates.set(postCandidate.id, { segment: postCandidate, groupID: -1 });
-                    } else if (postCandidate.canSpawn) {
-                        // canSpawn is a postCandidate property that might be different for each selected segment.
-                        // Allow post-side segment to spawn if one of the postCandidates canSpawn properties is true. 
-                        postCandidates.get(postCandidate.id).segment.canSpawn = true;
-                    }
-                }
-            }
-        }
-
-        // Connected components using BFS on post-side candidates
-        let postGroups = [];
-        for (const segID of postCandidates.keys()) {
-            if (postCandidates.get(segID).groupID !== -1) {
-                continue;
-            }
-
-            const queue = [segID];
-            const groupID = postGroups.length;
-            postGroups[groupID] = new Set();
-
-            while (queue.length > 0) {
-                const seg = queue.pop();
-                postCandidates.get(seg).groupID = groupID;
-                postGroups[groupID].add(seg);
-                if (regionGraph[seg]) {
-                    for (const regiongraphNeighbor of regionGraph[seg].postSideNeighbors) {
-                        if (postCandidates.get(regiongraphNeighbor.id) && postCandidates.get(regiongraphNeighbor.id).groupID === -1) {
-                            queue.push(regiongraphNeighbor.id);
-                        }
-                    }
-                }
-            }
-        }
-
-        let result = [];
-        // Remove segments that don't have enough coverage
-        for (const group of postGroups) {
-            const groupID = result.length;
-            let bestMatch = null;
-            for (const postSegID of group) {
-                const postSeg = postCandidates.get(postSegID).segment;
-                const requiredSize = match_ratio * postSeg.overlapSize;
-                let accumSize = 0;
-                for (const preSeg of postSeg.preSideSupports) {
-                    if (selection.has(preSeg.id)) {
-                        accumSize += preSeg.intersectionSize;
-                    }
-                }
-
-                if (accumSize >= requiredSize) {
-                    result[groupID] = result[groupID] || new Map();
-                    result[groupID].set(postSeg.id, postSeg.overlapSize);
-                }
 
-                // Store best (valid) match in case we don't find a single valid post-segment for this spawn group
-                const matchScore = (accumSize + 1000.0) / (postSeg.overlapSize + 2000.0);
-                if (postSeg.canSpawn && (!bestMatch || matchScore > bestMatch.score)) {
-                    bestMatch = { segID: postSeg.id, score: matchScore, size: postSeg.overlapSize, mappedSize: accumSize }
-                }
-            }
-            // No valid post-segment found (or only no-spawn segments), so add the best match we got (if any)
-            if (bestMatch && (!result[groupID] || [...result[groupID].keys()].every((postSegID) => {
-                return postCandidates.get(postSegID).segment.canSpawn === false
-            }))) {
-                result[groupID] = result[groupID] || new Map();
-                result[groupID].set(bestMatch.segID, bestMatch.size);
-                console.log("No perfect seed found. Chose seg " + bestMatch.segID + " with " + bestMatch.mappedSize + " / " + bestMatch.size + " voxels matching.");
-            }
+    yield loadSpawnTableIndex(spawntable_path)
+    .then(function(indexPtr) {
+        const taskSpawnerPtr = SpawnTableIndexLib.SpawnTableIndex_QuerySeeds64(indexPtr, segmentsToBuffer64(segments), segments.length, match_ratio);
+        if (taskSpawnerPtr.isNull()) {
+            throw new TypeError(`get_seeds failed for ${spawntable_path}.`);
         }
+        const result = readSpawnSets(taskSpawnerPtr, SpawnSeed64, Segment64);
+        SpawnTableIndexLib.SpawnTableIndex_ReleaseSeeds64(taskSpawnerPtr);
 
-        // Remove groups that *only* consist of segments not allowed to spawn (dust, or near boundary)
-        result = result.filter((group) => { return [...group.keys()].some((postSegID) => { return postCandidates.get(postSegID).segment.canSpawn === true }) });
-
-        const result_str = JSON.stringify(result.map((map) => { return strMapToObj(map) }));
+        const result_str = JSON.stringify(result);
         console.log(result_str)
         console.timeEnd("get_seeds for " + spawntable_path);
         _this.body = result_str;
@@ -506,26 +528,7 @@ app.post('/get_seeds_old', null, {
         };
         console.time("get_seeds for " + path_pre + " to " + path_post);
         let taskSpawnerPtr = generateSpawnCandidates(pre, post, segments, match_ratio);
-        let taskSpawner = taskSpawnerPtr.deref();
-        var result = [];
-
-        if (taskSpawner.spawnSetCount > 0) {
-            let spawnSetArray = taskSpawner.seeds.ref().readPointer(0, taskSpawner.spawnSetCount * SpawnSeed.size);
-            
-            for (let i = 0; i < taskSpawner.spawnSetCount; ++i) {
-                let spawnSet = ref.get(spawnSetArray, i * SpawnSeed.size, SpawnSeed);
-                if (spawnSet.segmentCount > 0) {
-                    let segmentArray = spawnSet.segments.ref().readPointer(0, spawnSet.segmentCount * Segment.size);
-                    
-                    let set = {}
-                    for (let j = 0; j < spawnSet.segmentCount; ++j) {
-                        let segment = ref.get(segmentArray, j * Segment.size, Segment);
-                        set[segment.id] = segment.size;
-                    }
-                    result.push(set);
-                }
-            }
-        }
+        let result = readSpawnSets(taskSpawnerPtr);
 
         TaskSpawnerLib.TaskSpawner_Release(taskSpawnerPtr);
 
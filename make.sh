@@ -3,28 +3,60 @@ GCC="g++-5"
 ZILIBDIR="./third_party/zi_lib"
 JSONDIR="./third_party/json/src"
 VMMLIBDIR="./third_party/vmmlib"
+PROTOC="${PROTOC:-protoc}"
+PROTOC_VERSION="libprotoc 3.2.0"   # has to match the libprotobuf.a linked below
 
 CXXINCLUDES="-I/usr/include -I./include -I$ZILIBDIR -I$JSONDIR -I$VMMLIBDIR"
 CXXLIBS="-L./lib -L/usr/lib -L/usr/lib/x86_64-linux-gnu -L/lib/x86_64-linux-gnu"
-COMMON_FLAGS="-fPIC -g -std=c++11"
+COMMON_FLAGS="-fPIC -g -std=c++11 -pthread"
 OPTIMIZATION_FLAGS="-DNDEBUG -O3"
 
 mkdir -p build
 mkdir -p lib
 mkdir -p bin
 
+echo "Generating res/spawnset.pb.h and res/spawnset.pb.cc"
+if [ "$($PROTOC --version 2>/dev/null)" != "$PROTOC_VERSION" ]; then
+  echo "$PROTOC_VERSION is required, $PROTOC is '$($PROTOC --version 2>&1)'; set PROTOC to its path."
+  exit 1
+fi
+$PROTOC --proto_path=res --cpp_out=res res/spawnset.proto || exit 1
+
 echo "Compiling Spawner"
 $GCC -c $CXXINCLUDES $CXXLIBS $COMMON_FLAGS $OPTIMIZATION_FLAGS src/Volume.cpp -o build/Volume.o
+$GCC -c $CXXINCLUDES $CXXLIBS $COMMON_FLAGS $OPTIMIZATION_FLAGS src/MetadataReader.cpp -o build/MetadataReader.o
+$GCC -c $CXXINCLUDES $CXXLIBS $COMMON_FLAGS $OPTIMIZATION_FLAGS src/LZMA.cpp -o build/LZMA.o
+$GCC -c $CXXINCLUDES $CXXLIBS $COMMON_FLAGS $OPTIMIZATION_FLAGS src/BlockSegmentation.cpp -o build/BlockSegmentation.o
+$GCC -c $CXXINCLUDES $CXXLIBS $COMMON_FLAGS $OPTIMIZATION_FLAGS src/PaletteSegmentation.cpp -o build/PaletteSegmentation.o
 $GCC -c $CXXINCLUDES $CXXLIBS $COMMON_FLAGS $OPTIMIZATION_FLAGS src/SpawnerWrapper.cpp -o build/SpawnerWrapper.o
 
 #$GCC -c $CXXINCLUDES $CXXLIBS $COMMON_FLAGS $OPTIMIZATION_FLAGS src/test.cpp -o build/test.o
-#$GCC $CXXINCLUDES $CXXLIBS $COMMON_FLAGS $OPTIMIZATION_FLAGS -o bin/test build/Volume.o build/test.o
+#$GCC $CXXINCLUDES $CXXLIBS $COMMON_FLAGS $OPTIMIZATION_FLAGS -o bin/test build/Volume.o build/MetadataReader.o build/LZMA.o build/BlockSegmentation.o build/PaletteSegmentation.o build/test.o -llzma -llz4
 
 $GCC -c $CXXINCLUDES $CXXLIBS $COMMON_FLAGS $OPTIMIZATION_FLAGS src/SpawnSetGenerator.cpp -o build/SpawnSetGenerator.o
 $GCC -c $CXXINCLUDES $CXXLIBS $COMMON_FLAGS $OPTIMIZATION_FLAGS res/spawnset.pb.cc -o build/spawnset.pb.o
-#$GCC $CXXINCLUDES $CXXLIBS $COMMON_FLAGS $OPTIMIZATION_FLAGS -o bin/spawnsetgenerator build/Volume.o build/spawnset.pb.o build/SpawnSetGenerator.o -l:libprotobuf.a
+$GCC -c $CXXINCLUDES $CXXLIBS $COMMON_FLAGS $OPTIMIZATION_FLAGS src/FlatSpawnTable.cpp -o build/FlatSpawnTable.o
+$GCC -c $CXXINCLUDES $CXXLIBS $COMMON_FLAGS $OPTIMIZATION_FLAGS src/SpawnTableIndex.cpp -o build/SpawnTableIndex.o
+$GCC -c $CXXINCLUDES $CXXLIBS $COMMON_FLAGS $OPTIMIZATION_FLAGS src/ChunkLoader.cpp -o build/ChunkLoader.o
+$GCC -c $CXXINCLUDES $CXXLIBS $COMMON_FLAGS $OPTIMIZATION_FLAGS src/SpawnFaces.cpp -o build/SpawnFaces.o
+$GCC -c $CXXINCLUDES $CXXLIBS $COMMON_FLAGS $OPTIMIZATION_FLAGS src/ThreadPool.cpp -o build/ThreadPool.o
+$GCC -c $CXXINCLUDES $CXXLIBS $COMMON_FLAGS $OPTIMIZATION_FLAGS src/ChunkCache.cpp -o build/ChunkCache.o
+$GCC -c $CXXINCLUDES $CXXLIBS $COMMON_FLAGS $OPTIMIZATION_FLAGS src/SpawnBatch.cpp -o build/SpawnBatch.o
+$GCC -c $CXXINCLUDES $CXXLIBS $COMMON_FLAGS $OPTIMIZATION_FLAGS src/SegBlocks.cpp -o build/SegBlocks.o
+$GCC -c $CXXINCLUDES $CXXLIBS $COMMON_FLAGS $OPTIMIZATION_FLAGS src/SpawnBench.cpp -o build/SpawnBench.o
+#$GCC $CXXINCLUDES $CXXLIBS $COMMON_FLAGS $OPTIMIZATION_FLAGS -o bin/spawnsetgenerator build/Volume.o build/MetadataReader.o build/LZMA.o build/BlockSegmentation.o build/PaletteSegmentation.o build/spawnset.pb.o build/FlatSpawnTable.o build/SpawnSetGenerator.o build/ThreadPool.o -l:libprotobuf.a -llzma -llz4
 
 #echo "Creating libspawner.so"
-$GCC $CXXLIBS -shared -fPIC -o lib/libspawner.so build/Volume.o build/SpawnerWrapper.o
+$GCC $CXXLIBS -shared -fPIC -o lib/libspawner.so build/Volume.o build/MetadataReader.o build/LZMA.o build/BlockSegmentation.o build/PaletteSegmentation.o build/SpawnerWrapper.o -llzma -llz4
+
+$GCC $CXXLIBS -shared -fPIC -pthread -o lib/spawnsetgenerator.so build/Volume.o build/MetadataReader.o build/LZMA.o build/BlockSegmentation.o build/PaletteSegmentation.o build/spawnset.pb.o build/FlatSpawnTable.o build/SpawnSetGenerator.o build/ThreadPool.o -l:libprotobuf.a -llzma -llz4
+
+$GCC $CXXLIBS -shared -fPIC -o lib/libspawntableindex.so build/spawnset.pb.o build/FlatSpawnTable.o build/SpawnTableIndex.o -l:libprotobuf.a
+
+$GCC $CXXLIBS $COMMON_FLAGS -o bin/spawnfaces build/Volume.o build/MetadataReader.o build/LZMA.o build/BlockSegmentation.o build/PaletteSegmentation.o build/spawnset.pb.o build/FlatSpawnTable.o build/SpawnSetGenerator.o build/ThreadPool.o build/ChunkLoader.o build/SpawnFaces.o -l:libprotobuf.a -llzma -llz4
+
+$GCC $CXXLIBS $COMMON_FLAGS -o bin/spawnbatch build/Volume.o build/MetadataReader.o build/LZMA.o build/BlockSegmentation.o build/PaletteSegmentation.o build/spawnset.pb.o build/FlatSpawnTable.o build/SpawnSetGenerator.o build/ChunkLoader.o build/ChunkCache.o build/ThreadPool.o build/SpawnBatch.o -l:libprotobuf.a -llzma -llz4
+
+$GCC $CXXLIBS $COMMON_FLAGS -o bin/segblocks build/Volume.o build/MetadataReader.o build/LZMA.o build/BlockSegmentation.o build/PaletteSegmentation.o build/ChunkLoader.o build/SegBlocks.o -llzma -llz4
 
-$GCC $CXXLIBS -shared -fPIC -o lib/spawnsetgenerator.so build/Volume.o build/spawnset.pb.o build/SpawnSetGenerator.o -l:libprotobuf.a
+$GCC $CXXLIBS $COMMON_FLAGS -o bin/spawnbench build/Volume.o build/MetadataReader.o build/LZMA.o build/BlockSegmentation.o build/PaletteSegmentation.o build/spawnset.pb.o build/FlatSpawnTable.o build/SpawnSetGenerator.o build/ThreadPool.o build/SpawnTableIndex.o build/SpawnBench.o -l:libprotobuf.a -llzma -llz4
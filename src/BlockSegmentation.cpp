@@ -0,0 +1,168 @@
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include <lz4.h>
+
+#include "BlockSegmentation.h"
+
+/*****************************************************************/
+
+void writeBlockSegmentation(std::vector<unsigned char> &buffer, const CBufferView &segmentation, const vmml::Vector<3, int64_t> &dimensions, uint32_t voxelSize, const vmml::Vector<3, int64_t> &blockSize) {
+  if (segmentation.length < size_t(dimensions.x() * dimensions.y() * dimensions.z()) * voxelSize) {
+    throw std::string("Segmentation buffer is smaller than the volume dimensions.");
+  }
+
+  CBlockSegmentationHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, BLOCK_SEGMENTATION_MAGIC, sizeof(header.magic));
+  header.version = BLOCK_SEGMENTATION_VERSION;
+  header.voxelSize = voxelSize;
+
+  vmml::Vector<3, int64_t> grid;
+  for (int axis = 0; axis < 3; ++axis) {
+    header.dimensions[axis] = uint64_t(dimensions[axis]);
+    header.blockSize[axis] = uint64_t(std::max<int64_t>(1, blockSize[axis]));
+    grid[axis] = (dimensions[axis] + int64_t(header.blockSize[axis]) - 1) / int64_t(header.blockSize[axis]);
+  }
+  header.blockCount = uint64_t(grid.x() * grid.y() * grid.z());
+
+  std::vector<uint64_t> offsets;
+  offsets.reserve(size_t(header.blockCount) + 1);
+  buffer.assign(sizeof(header) + (size_t(header.blockCount) + 1) * sizeof(uint64_t), 0);
+
+  std::vector<unsigned char> block;
+  for (int64_t bz = 0; bz < grid.z(); ++bz) {
+    for (int64_t by = 0; by < grid.y(); ++by) {
+      for (int64_t bx = 0; bx < grid.x(); ++bx) {
+        const vmml::Vector<3, int64_t> min(bx * int64_t(header.blockSize[0]), by * int64_t(header.blockSize[1]), bz * int64_t(header.blockSize[2]));
+        const vmml::Vector<3, int64_t> max(std::min(min.x() + int64_t(header.blockSize[0]), dimensions.x()),
+                                           std::min(min.y() + int64_t(header.blockSize[1]), dimensions.y()),
+                                           std::min(min.z() + int64_t(header.blockSize[2]), dimensions.z()));
+        const size_t rowSize = size_t(max.x() - min.x()) * voxelSize;
+
+        block.clear();
+        for (int64_t z = min.z(); z < max.z(); ++z) {
+          for (int64_t y = min.y(); y < max.y(); ++y) {
+            const unsigned char * row = segmentation.data + size_t(min.x() + y * dimensions.x() + z * dimensions.x() * dimensions.y()) * voxelSize;
+            block.insert(block.end(), row, row + rowSize);
+          }
+        }
+
+        offsets.push_back(buffer.size());
+        const size_t begin = buffer.size();
+        buffer.resize(begin + size_t(LZ4_compressBound(int(block.size()))));
+        const int compressed = LZ4_compress_default(reinterpret_cast<const char *>(block.data()), reinterpret_cast<char *>(buffer.data() + begin), int(block.size()), int(buffer.size() - begin));
+        if (compressed <= 0) {
+          throw std::string("LZ4 compression failed.");
+        }
+        buffer.resize(begin + size_t(compressed));
+      }
+    }
+  }
+  offsets.push_back(buffer.size());
+
+  memcpy(buffer.data(), &header, sizeof(header));
+  memcpy(buffer.data() + sizeof(header), offsets.data(), offsets.size() * sizeof(uint64_t));
+}
+
+/*****************************************************************/
+
+bool CBlockSegmentationReader::IsBlockSegmentation(const CBufferView &buffer) {
+  return buffer.length >= sizeof(CBlockSegmentationHeader) && memcmp(buffer.data, BLOCK_SEGMENTATION_MAGIC, sizeof(BLOCK_SEGMENTATION_MAGIC)) == 0;
+}
+
+CBlockSegmentationReader::CBlockSegmentationReader(const CBufferView &buffer) : buffer_(buffer.data), length_(buffer.length) {
+  if (!IsBlockSegmentation(buffer)) {
+    throw std::string("Not a block segmentation.");
+  }
+
+  // The buffer need not be aligned, so the header and offsets are copied out
+  memcpy(&header_, buffer_, sizeof(header_));
+  if (header_.version != BLOCK_SEGMENTATION_VERSION) {
+    throw std::string("Block segmentation version is ") + std::to_string(header_.version) + ", but " + std::to_string(BLOCK_SEGMENTATION_VERSION) + " expected!";
+  }
+
+  uint64_t blockCount = 1;
+  for (int axis = 0; axis < 3; ++axis) {
+    if (header_.blockSize[axis] == 0 || header_.blockSize[axis] > (uint64_t(1) << 31) || header_.dimensions[axis] > (uint64_t(1) << 31)) {
+      throw std::string("Block segmentation header is corrupt.");
+    }
+    dimensions_[axis] = int64_t(header_.dimensions[axis]);
+    blockSize_[axis] = int64_t(header_.blockSize[axis]);
+    blockGrid_[axis] = (dimensions_[axis] + blockSize_[axis] - 1) / blockSize_[axis];
+    blockCount *= uint64_t(blockGrid_[axis]);
+  }
+  if (header_.voxelSize == 0 || header_.voxelSize > 8 || blockCount != header_.blockCount || blockCount >= length_ ||
+      sizeof(header_) + (blockCount + 1) * sizeof(uint64_t) > length_) {
+    throw std::string("Block segmentation header is corrupt.");
+  }
+
+  uint64_t previous = sizeof(header_) + (blockCount + 1) * sizeof(uint64_t);
+  for (uint64_t block = 0; block <= blockCount; ++block) {
+    const uint64_t offset = blockOffset(int64_t(block));
+    if (offset < previous || offset > length_) {
+      throw std::string("Block segmentation offsets are corrupt.");
+    }
+    previous = offset;
+  }
+}
+
+uint64_t CBlockSegmentationReader::blockOffset(int64_t block) const {
+  uint64_t offset;
+  memcpy(&offset, buffer_ + sizeof(header_) + size_t(block) * sizeof(uint64_t), sizeof(offset));
+  return offset;
+}
+
+void CBlockSegmentationReader::Read(const vmml::AABB<int64_t> &bounds, unsigned char * out) const {
+  const size_t voxelSize = header_.voxelSize;
+  const vmml::Vector<3, int64_t> dimBounds = bounds.getDimension();
+  if (dimBounds.x() <= 0 || dimBounds.y() <= 0 || dimBounds.z() <= 0) {
+    return;
+  }
+
+  vmml::Vector<3, int64_t> firstBlock, lastBlock;
+  for (int axis = 0; axis < 3; ++axis) {
+    if (bounds.getMin()[axis] < 0 || bounds.getMax()[axis] > dimensions_[axis]) {
+      throw std::string("Bounds exceed the block segmentation.");
+    }
+    firstBlock[axis] = bounds.getMin()[axis] / blockSize_[axis];
+    lastBlock[axis] = (bounds.getMax()[axis] - 1) / blockSize_[axis];
+  }
+
+  std::vector<unsigned char> block(size_t(std::min(blockSize_.x(), dimensions_.x()) * std::min(blockSize_.y(), dimensions_.y()) * std::min(blockSize_.z(), dimensions_.z())) * voxelSize);
+  for (int64_t bz = firstBlock.z(); bz <= lastBlock.z(); ++bz) {
+    for (int64_t by = firstBlock.y(); by <= lastBlock.y(); ++by) {
+      for (int64_t bx = firstBlock.x(); bx <= lastBlock.x(); ++bx) {
+        const vmml::Vector<3, int64_t> blockMin(bx * blockSize_.x(), by * blockSize_.y(), bz * blockSize_.z());
+        const vmml::Vector<3, int64_t> blockDim(std::min(blockSize_.x(), dimensions_.x() - blockMin.x()),
+                                                std::min(blockSize_.y(), dimensions_.y() - blockMin.y()),
+                                                std::min(blockSize_.z(), dimensions_.z() - blockMin.z()));
+        const size_t blockLength = size_t(blockDim.x() * blockDim.y() * blockDim.z()) * voxelSize;
+
+        const int64_t index = bx + by * blockGrid_.x() + bz * blockGrid_.x() * blockGrid_.y();
+        const uint64_t begin = blockOffset(index);
+        const uint64_t end = blockOffset(index + 1);
+        const int decompressed = LZ4_decompress_safe(reinterpret_cast<const char *>(buffer_ + begin), reinterpret_cast<char *>(block.data()), int(end - begin), int(blockLength));
+        if (decompressed != int(blockLength)) {
+          throw std::string("Block segmentation block is corrupt.");
+        }
+
+        // Part of the block inside bounds, in volume coordinates
+        vmml::Vector<3, int64_t> min, max;
+        for (int axis = 0; axis < 3; ++axis) {
+          min[axis] = std::max(bounds.getMin()[axis], blockMin[axis]);
+          max[axis] = std::min(bounds.getMax()[axis], blockMin[axis] + blockDim[axis]);
+        }
+        const size_t rowSize = size_t(max.x() - min.x()) * voxelSize;
+        for (int64_t z = min.z(); z < max.z(); ++z) {
+          for (int64_t y = min.y(); y < max.y(); ++y) {
+            const size_t from = size_t((min.x() - blockMin.x()) + (y - blockMin.y()) * blockDim.x() + (z - blockMin.z()) * blockDim.x() * blockDim.y());
+            const size_t to = size_t((min.x() - bounds.getMin().x()) + (y - bounds.getMin().y()) * dimBounds.x() + (z - bounds.getMin().z()) * dimBounds.x() * dimBounds.y());
+            memcpy(out + to * voxelSize, block.data() + from * voxelSize, rowSize);
+          }
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,79 @@
+#include "ChunkCache.h"
+
+/*****************************************************************/
+
+CChunkCache::CChunkCache(const std::string &root, size_t budget, bool palette) : root_(root), budget_(budget), palette_(palette), bytes_(0), nextID_(0) {
+  if (!root_.empty() && root_.back() != '/') {
+    root_ += "/";
+  }
+}
+
+std::shared_ptr<const CChunk> CChunkCache::Get(const std::string &path) {
+  std::promise<std::shared_ptr<const CChunk>> promise;
+  CChunkFuture chunk;
+  uint64_t id = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(path);
+    if (it != entries_.end()) {
+      lru_.splice(lru_.begin(), lru_, it->second.lru);
+      chunk = it->second.chunk;
+    } else {
+      lru_.push_front(path);
+      id = nextID_++;
+      CEntry entry = { promise.get_future().share(), lru_.begin(), id, 0 };
+      entries_.insert(std::make_pair(path, entry));
+    }
+  }
+
+  // Hit, possibly still being loaded by another thread
+  if (chunk.valid()) {
+    return chunk.get();
+  }
+
+  try {
+    std::shared_ptr<const CChunk> loaded = std::make_shared<CChunk>(root_ + path, palette_);
+    promise.set_value(loaded);
+
+    // Entry may have been replaced meanwhile, if a failed load removed it
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(path);
+    if (it != entries_.end() && it->second.id == id) {
+      it->second.bytes = loaded->GetByteSize();
+      bytes_ += it->second.bytes;
+      evict();
+    }
+    return loaded;
+  } catch (...) {
+    // Waiting threads get the error too; later requests retry the load
+    promise.set_exception(std::current_exception());
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(path);
+    if (it != entries_.end() && it->second.id == id) {
+      lru_.erase(it->second.lru);
+      entries_.erase(it);
+    }
+    throw;
+  }
+}
+
+size_t CChunkCache::GetByteSize() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return bytes_;
+}
+
+// Drops least recently used chunks that are loaded and not referenced outside the cache
+// until the budget is met, or nothing else can be dropped.
+void CChunkCache::evict() {
+  auto it = lru_.end();
+  while (bytes_ > budget_ && it != lru_.begin()) {
+    --it;
+    auto entry = entries_.find(*it);
+    if (entry->second.bytes == 0 || entry->second.chunk.get().use_count() > 1) {
+      continue;
+    }
+    bytes_ -= entry->second.bytes;
+    entries_.erase(entry);
+    it = lru_.erase(it);
+  }
+}
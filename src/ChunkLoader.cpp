@@ -0,0 +1,93 @@
+#include <fstream>
+
+#include "ChunkLoader.h"
+#include "MetadataReader.h"
+
+/*****************************************************************/
+
+std::vector<unsigned char> readFile(const std::string &filename) {
+  std::ifstream f(filename, std::ifstream::binary);
+  if (!f) {
+    throw std::string("Could not open " + filename);
+  }
+  f.seekg(0, std::ifstream::end);
+  std::vector<unsigned char> buffer(size_t(f.tellg()));
+  f.seekg(0);
+  f.read(reinterpret_cast<char *>(buffer.data()), std::streamsize(buffer.size()));
+  if (!f) {
+    throw std::string("Could not read " + filename);
+  }
+  return buffer;
+}
+
+static bool fileExists(const std::string &filename) {
+  return std::ifstream(filename).good();
+}
+
+// metadata.bin if the chunk has the binary sidecar, metadata.json otherwise
+static std::vector<unsigned char> readMetadataFile(const std::string &dir) {
+  return readFile(dir + (fileExists(dir + "metadata.bin") ? "metadata.bin" : "metadata.json"));
+}
+
+std::string chunkName(const std::string &path) {
+  size_t end = path.find_last_not_of('/');
+  if (end == std::string::npos) {
+    return "";
+  }
+  size_t begin = path.find_last_of('/', end);
+  begin = (begin == std::string::npos) ? 0 : begin + 1;
+  return path.substr(begin, end + 1 - begin);
+}
+
+vmml::Vector<3, int64_t> readChunkOffset(const std::string &path) {
+  const std::string dir = (path.empty() || path.back() == '/') ? path : path + "/";
+  CMetadataFields fields;
+  readMetadata(CBufferView(readMetadataFile(dir)), fields);
+  return fields.physicalOffsetMin;
+}
+
+/*****************************************************************/
+
+CChunk::CChunk(const std::string &path, bool palette) {
+  const std::string dir = (path.empty() || path.back() == '/') ? path : path + "/";
+
+  std::vector<unsigned char> metadata = readMetadataFile(dir);
+  metadata_.assign(metadata.begin(), metadata.end());
+  bboxes_ = readFile(dir + "segmentation.bbox");
+  sizes_ = readFile(dir + "segmentation.size");
+  if (fileExists(dir + "segmentation.ids")) {
+    ids_ = readFile(dir + "segmentation.ids");
+  }
+
+  // Sparse if the chunk lists its segment IDs, the sizes and bounding boxes are per listed ID
+  std::unique_ptr<CVolumeMetadata> meta(new CVolumeMetadata(
+    CBufferView(reinterpret_cast<const unsigned char *>(metadata_.data()), metadata_.size()),
+    ids_.empty() ? CBufferView() : CBufferView(ids_),
+    CBufferView(bboxes_),
+    CBufferView(sizes_)));
+  meta->CompactSegments();
+  if (meta->OwnsSegmentArrays()) {
+    std::vector<unsigned char>().swap(bboxes_);
+    std::vector<unsigned char>().swap(sizes_);
+  }
+  const vmml::AABB<int64_t> bounds(vmml::Vector<3, int64_t>(0, 0, 0), meta->GetVolumeDimensions());
+  if (fileExists(dir + "segmentation.blocks")) {
+    volume_.reset(new CVolume(std::move(meta), CBufferView(readFile(dir + "segmentation.blocks")), bounds));
+  } else if (fileExists(dir + "segmentation.lzma")) {
+    // Decoded straight into storage owned by the volume
+    volume_.reset(new CVolume(std::move(meta), CBufferView(readFile(dir + "segmentation.lzma")), bounds));
+  } else {
+    segmentation_ = readFile(dir + "segmentation");
+    volume_.reset(new CVolume(std::move(meta), CBufferView(segmentation_)));
+  }
+
+  // Palettes hold 32-bit IDs, wider segmentations stay dense
+  if (palette && volume_->GetSegmentIdType() != MetaDataType::UInt64) {
+    volume_->ConvertToPalette();
+    std::vector<unsigned char>().swap(segmentation_);
+  }
+}
+
+size_t CChunk::GetByteSize() const {
+  return metadata_.size() + ids_.size() + bboxes_.size() + sizes_.size() + volume_->GetSegmentationByteSize() + volume_->GetMetadata().GetByteSize();
+}
@@ -0,0 +1,724 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+#include "FlatSpawnTable.h"
+#include "GroupVarint.h"
+
+#include "../res/spawnset.pb.h"
+
+using namespace ew;
+
+/*****************************************************************/
+
+template <typename T>
+static void appendSection(std::vector<unsigned char> & buffer, CFlatSpawnTableHeader & header, FlatSpawnTableSection section, const std::vector<T> & values) {
+  buffer.resize((buffer.size() + 7) & ~size_t(7), 0);
+  header.sectionOffsets[section] = buffer.size();
+  const unsigned char * bytes = reinterpret_cast<const unsigned char *>(values.data());
+  buffer.insert(buffer.end(), bytes, bytes + values.size() * sizeof(T));
+}
+
+// Segment ID section, narrowed to uint32 unless wide
+static void appendIDSection(std::vector<unsigned char> & buffer, CFlatSpawnTableHeader & header, FlatSpawnTableSection section, const std::vector<uint64_t> & ids, bool wide) {
+  if (wide) {
+    appendSection(buffer, header, section, ids);
+  } else {
+    appendSection(buffer, header, section, std::vector<uint32_t>(ids.begin(), ids.end()));
+  }
+}
+
+static bool hasWideIDs(const std::vector<uint64_t> & ids) {
+  for (uint64_t id : ids) {
+    if (id > UINT32_MAX) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool CFlatSpawnTableData::HasWideIDs() const {
+  return hasWideIDs(preIDs) || hasWideIDs(postIDs) || hasWideIDs(supportIDs) || hasWideIDs(graphIDs) || hasWideIDs(graphNeighbors);
+}
+
+static CFlatSpawnTableHeader makeHeader(const CFlatSpawnTableData & data, uint32_t version) {
+  CFlatSpawnTableHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, FLAT_SPAWN_TABLE_MAGIC, sizeof(header.magic));
+  header.version = version;
+  header.preCount = data.preIDs.size();
+  header.counterpartCount = data.counterpartPosts.size();
+  header.postCount = data.postIDs.size();
+  header.supportCount = data.supportIDs.size();
+  header.graphCount = data.graphIDs.size();
+  header.neighborCount = data.graphNeighbors.size();
+  return header;
+}
+
+template <typename T>
+static bool isAscending(const std::vector<T> & values, const std::vector<uint32_t> & offsets) {
+  for (size_t i = 0; i + 1 < offsets.size(); ++i) {
+    for (uint32_t v = offsets[i] + 1; v < offsets[i + 1]; ++v) {
+      if (values[v - 1] >= values[v]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool CFlatSpawnTableData::CanPack() const {
+  if (HasWideIDs() || postIDs.size() > (UINT32_MAX >> 1)) {
+    return false;
+  }
+  if (!isAscending(counterpartPosts, preOffsets) || !isAscending(supportIDs, postOffsets) || !isAscending(graphNeighbors, graphOffsets)) {
+    return false;
+  }
+
+  // Every edge has to be listed by both of its segments
+  std::vector<std::pair<uint64_t, uint64_t>> upper, lower;
+  for (size_t graph = 0; graph < graphIDs.size(); ++graph) {
+    for (uint32_t n = graphOffsets[graph]; n < graphOffsets[graph + 1]; ++n) {
+      if (graphNeighbors[n] > graphIDs[graph]) {
+        upper.push_back(std::make_pair(graphIDs[graph], graphNeighbors[n]));
+      } else if (graphNeighbors[n] < graphIDs[graph]) {
+        lower.push_back(std::make_pair(graphNeighbors[n], graphIDs[graph]));
+      } else {
+        return false;
+      }
+    }
+  }
+  std::sort(lower.begin(), lower.end());
+  return upper == lower;
+}
+
+// Flat version 3, see FlatSpawnTable.h. Returns false if a stream outgrows 32-bit offsets.
+static bool writePacked(const CFlatSpawnTableData & data, std::vector<unsigned char> & buffer) {
+  std::vector<uint32_t> values;
+
+  std::vector<unsigned char> counterpartStream;
+  std::vector<uint32_t> preOffsets(1, 0);
+  for (size_t pre = 0; pre + 1 < data.preOffsets.size(); ++pre) {
+    values.clear();
+    uint32_t previous = 0;
+    for (uint32_t c = data.preOffsets[pre]; c < data.preOffsets[pre + 1]; ++c) {
+      values.push_back(((data.counterpartPosts[c] - previous) << 1) | (data.counterpartCanSpawn[c] ? 1 : 0));
+      previous = data.counterpartPosts[c];
+    }
+    appendGroupVarintList(counterpartStream, values.data(), values.size());
+    preOffsets.push_back(uint32_t(counterpartStream.size()));
+  }
+
+  std::vector<unsigned char> supportStream;
+  std::vector<uint32_t> postOffsets(1, 0);
+  for (size_t post = 0; post + 1 < data.postOffsets.size(); ++post) {
+    values.clear();
+    uint64_t previous = 0;
+    for (uint32_t s = data.postOffsets[post]; s < data.postOffsets[post + 1]; ++s) {
+      values.push_back(uint32_t(data.supportIDs[s] - previous));
+      previous = data.supportIDs[s];
+    }
+    values.insert(values.end(), data.supportSizes.begin() + data.postOffsets[post], data.supportSizes.begin() + data.postOffsets[post + 1]);
+    appendGroupVarintList(supportStream, values.data(), values.size());
+    postOffsets.push_back(uint32_t(supportStream.size()));
+  }
+
+  std::vector<unsigned char> neighborStream;
+  std::vector<uint32_t> graphIDs;
+  std::vector<uint32_t> graphOffsets(1, 0);
+  size_t neighborCount = 0;
+  for (size_t graph = 0; graph < data.graphIDs.size(); ++graph) {
+    values.clear();
+    uint64_t previous = data.graphIDs[graph];
+    for (uint32_t n = data.graphOffsets[graph]; n < data.graphOffsets[graph + 1]; ++n) {
+      if (data.graphNeighbors[n] > data.graphIDs[graph]) {
+        values.push_back(uint32_t(data.graphNeighbors[n] - previous));
+        previous = data.graphNeighbors[n];
+      }
+    }
+    if (!values.empty()) {
+      appendGroupVarintList(neighborStream, values.data(), values.size());
+      graphIDs.push_back(uint32_t(data.graphIDs[graph]));
+      graphOffsets.push_back(uint32_t(neighborStream.size()));
+      neighborCount += values.size();
+    }
+  }
+
+  for (std::vector<unsigned char> * stream : { &counterpartStream, &supportStream, &neighborStream }) {
+    if (stream->size() > UINT32_MAX) {
+      return false;
+    }
+    stream->resize(stream->size() + GROUP_VARINT_PADDING, 0);
+  }
+
+  CFlatSpawnTableHeader header = makeHeader(data, FLAT_SPAWN_TABLE_VERSION_PACKED);
+  header.graphCount = graphIDs.size();
+  header.neighborCount = neighborCount;
+
+  buffer.assign(sizeof(header), 0);
+  appendIDSection(buffer, header, PreIDs, data.preIDs, false);
+  appendSection(buffer, header, PreOffsets, preOffsets);
+  appendSection(buffer, header, CounterpartPosts, counterpartStream);
+  appendSection(buffer, header, CounterpartCanSpawn, std::vector<uint8_t>());
+  appendIDSection(buffer, header, PostIDs, data.postIDs, false);
+  appendSection(buffer, header, PostOverlapSizes, data.postOverlapSizes);
+  appendSection(buffer, header, PostOffsets, postOffsets);
+  appendSection(buffer, header, SupportIDs, supportStream);
+  appendSection(buffer, header, SupportSizes, std::vector<uint32_t>());
+  appendSection(buffer, header, GraphIDs, graphIDs);
+  appendSection(buffer, header, GraphOffsets, graphOffsets);
+  appendSection(buffer, header, GraphNeighbors, neighborStream);
+
+  memcpy(buffer.data(), &header, sizeof(header));
+  return true;
+}
+
+void CFlatSpawnTableData::Write(std::vector<unsigned char> & buffer, bool packed) const {
+  if (packed && CanPack() && writePacked(*this, buffer)) {
+    return;
+  }
+
+  const bool wide = HasWideIDs();
+  CFlatSpawnTableHeader header = makeHeader(*this, wide ? FLAT_SPAWN_TABLE_VERSION_64 : FLAT_SPAWN_TABLE_VERSION);
+
+  buffer.assign(sizeof(header), 0);
+  appendIDSection(buffer, header, PreIDs, preIDs, wide);
+  appendSection(buffer, header, PreOffsets, preOffsets);
+  appendSection(buffer, header, CounterpartPosts, counterpartPosts);
+  appendSection(buffer, header, CounterpartCanSpawn, counterpartCanSpawn);
+  appendIDSection(buffer, header, PostIDs, postIDs, wide);
+  appendSection(buffer, header, PostOverlapSizes, postOverlapSizes);
+  appendSection(buffer, header, PostOffsets, postOffsets);
+  appendIDSection(buffer, header, SupportIDs, supportIDs, wide);
+  appendSection(buffer, header, SupportSizes, supportSizes);
+  appendIDSection(buffer, header, GraphIDs, graphIDs, wide);
+  appendSection(buffer, header, GraphOffsets, graphOffsets);
+  appendIDSection(buffer, header, GraphNeighbors, graphNeighbors, wide);
+
+  memcpy(buffer.data(), &header, sizeof(header));
+}
+
+/*****************************************************************/
+
+void CFlatSpawnTableData::FromSpawnTable(const spawner::SpawnTable & spawntable) {
+  const uint32_t version = spawntable.version();
+  if (version != SPAWN_TABLE_VERSION && version != SPAWN_TABLE_VERSION_64 && version != SPAWN_TABLE_VERSION_SHARED) {
+    throw std::string("Spawn table version is ") + std::to_string(version) + ", but 1, 2 or 3 expected!";
+  }
+  const bool shared = (version == SPAWN_TABLE_VERSION_SHARED);
+
+  const auto & spawnMap = spawntable.prespawnmap();
+  const auto & regionGraph = spawntable.postregiongraph();
+
+  preIDs.clear();
+  for (const auto & entry : spawnMap) {
+    preIDs.push_back(entry.first);
+  }
+  std::sort(preIDs.begin(), preIDs.end());
+
+  postIDs.clear();
+  if (shared) {
+    for (const spawner::PostSegment & postSegment : spawntable.postsegments()) {
+      postIDs.push_back(postSegment.id());
+    }
+  } else {
+    for (uint64_t preID : preIDs) {
+      for (const spawner::PostSegment & counterpart : spawnMap.at(preID).postsidecounterparts()) {
+        postIDs.push_back(counterpart.id());
+      }
+    }
+  }
+  std::sort(postIDs.begin(), postIDs.end());
+  postIDs.erase(std::unique(postIDs.begin(), postIDs.end()), postIDs.end());
+  if (shared && postIDs.size() != size_t(spawntable.postsegments_size())) {
+    throw std::string("Spawn table lists a post-side segment twice.");
+  }
+
+  // Overlap size and supports describe the post-side segment alone. Up to version 2
+  // they are repeated for every pre-side segment it overlaps, only canSpawn differs
+  // between entries; version 3 stores them once in postSegments.
+  std::vector<const spawner::PostSegment *> postSegments(postIDs.size(), nullptr);
+  if (shared) {
+    for (const spawner::PostSegment & postSegment : spawntable.postsegments()) {
+      postSegments[std::lower_bound(postIDs.begin(), postIDs.end(), postSegment.id()) - postIDs.begin()] = &postSegment;
+    }
+  }
+
+  preOffsets.assign(1, 0);
+  counterpartPosts.clear();
+  counterpartCanSpawn.clear();
+  for (uint64_t preID : preIDs) {
+    for (const spawner::PostSegment & counterpart : spawnMap.at(preID).postsidecounterparts()) {
+      uint32_t post = uint32_t(std::lower_bound(postIDs.begin(), postIDs.end(), counterpart.id()) - postIDs.begin());
+      if (post == postIDs.size() || postIDs[post] != counterpart.id()) {
+        throw std::string("Spawn table counterpart ") + std::to_string(counterpart.id()) + " is not in postSegments.";
+      }
+      if (!postSegments[post]) {
+        postSegments[post] = &counterpart;
+      }
+      counterpartPosts.push_back(post);
+      counterpartCanSpawn.push_back(counterpart.canspawn() ? 1 : 0);
+    }
+    preOffsets.push_back(uint32_t(counterpartPosts.size()));
+  }
+
+  postOverlapSizes.clear();
+  postOffsets.assign(1, 0);
+  supportIDs.clear();
+  supportSizes.clear();
+  for (const spawner::PostSegment * postSegment : postSegments) {
+    postOverlapSizes.push_back(postSegment->overlapsize());
+    for (const spawner::PreSegment & support : postSegment->presidesupports()) {
+      supportIDs.push_back(support.id());
+      supportSizes.push_back(support.intersectionsize());
+    }
+    postOffsets.push_back(uint32_t(supportIDs.size()));
+  }
+
+  graphIDs.clear();
+  for (const auto & entry : regionGraph) {
+    graphIDs.push_back(entry.first);
+  }
+  std::sort(graphIDs.begin(), graphIDs.end());
+
+  graphOffsets.assign(1, 0);
+  graphNeighbors.clear();
+  for (uint64_t graphID : graphIDs) {
+    for (const spawner::PostSegment & neighbor : regionGraph.at(graphID).postsideneighbors()) {
+      graphNeighbors.push_back(neighbor.id());
+    }
+    graphOffsets.push_back(uint32_t(graphNeighbors.size()));
+  }
+}
+
+// Version written by ToSpawnTable and WriteSpawnTable
+static uint32_t spawnTableVersion(const CFlatSpawnTableData & data, bool sharedPosts) {
+  if (sharedPosts) {
+    return SPAWN_TABLE_VERSION_SHARED;
+  }
+  return data.HasWideIDs() ? SPAWN_TABLE_VERSION_64 : SPAWN_TABLE_VERSION;
+}
+
+void CFlatSpawnTableData::ToSpawnTable(spawner::SpawnTable & spawntable, bool sharedPosts) const {
+  spawntable.set_version(spawnTableVersion(*this, sharedPosts));
+
+  // Overlap size and supports of a post-side segment
+  auto setPostSegment = [this](spawner::PostSegment & postSegment, uint32_t post) {
+    postSegment.set_overlapsize(postOverlapSizes[post]);
+    postSegment.mutable_presidesupports()->Reserve(int(postOffsets[post + 1] - postOffsets[post]));
+    for (uint32_t s = postOffsets[post]; s < postOffsets[post + 1]; ++s) {
+      spawner::PreSegment* preSupport = postSegment.add_presidesupports();
+      preSupport->set_id(supportIDs[s]);
+      preSupport->set_intersectionsize(supportSizes[s]);
+    }
+  };
+
+  // Entries are filled where they live in the maps, nothing is copied or moved
+  auto& spawnEntries = *spawntable.mutable_prespawnmap();
+  for (size_t pre = 0; pre < preIDs.size(); ++pre) {
+    spawner::SpawnMapEntry& spawnEntry = spawnEntries[preIDs[pre]];
+    spawnEntry.mutable_postsidecounterparts()->Reserve(int(preOffsets[pre + 1] - preOffsets[pre]));
+    for (uint32_t c = preOffsets[pre]; c < preOffsets[pre + 1]; ++c) {
+      const uint32_t post = counterpartPosts[c];
+
+      spawner::PostSegment* postMatch = spawnEntry.add_postsidecounterparts();
+      postMatch->set_id(postIDs[post]);
+      postMatch->set_canspawn(counterpartCanSpawn[c] != 0);
+      if (!sharedPosts) {
+        setPostSegment(*postMatch, post);
+      }
+    }
+  }
+
+  if (sharedPosts) {
+    spawntable.mutable_postsegments()->Reserve(int(postIDs.size()));
+    for (uint32_t post = 0; post < postIDs.size(); ++post) {
+      spawner::PostSegment* postSegment = spawntable.add_postsegments();
+      postSegment->set_id(postIDs[post]);
+      setPostSegment(*postSegment, post);
+    }
+  }
+
+  auto& rgEntries = *spawntable.mutable_postregiongraph();
+  for (size_t graph = 0; graph < graphIDs.size(); ++graph) {
+    spawner::RegionGraphEntry& rgEntry = rgEntries[graphIDs[graph]];
+    rgEntry.mutable_postsideneighbors()->Reserve(int(graphOffsets[graph + 1] - graphOffsets[graph]));
+    for (uint32_t n = graphOffsets[graph]; n < graphOffsets[graph + 1]; ++n) {
+      spawner::PostSegment* postNeighbor = rgEntry.add_postsideneighbors();
+      postNeighbor->set_id(graphNeighbors[n]);
+    }
+  }
+}
+
+/*****************************************************************/
+
+// Protobuf wire format of SpawnTable, see res/spawnset.proto. Tags are single bytes
+// (field number << 3 | wire type); proto3 leaves out scalars that are 0.
+
+static inline size_t varintSize(uint64_t value) {
+  size_t size = 1;
+  while (value >= 0x80) {
+    value >>= 7;
+    ++size;
+  }
+  return size;
+}
+
+// Size of an optional scalar field including its tag
+static inline size_t scalarFieldSize(uint64_t value) {
+  return value ? 1 + varintSize(value) : 0;
+}
+
+// Size of a length delimited field including its tag
+static inline size_t messageFieldSize(size_t size) {
+  return 1 + varintSize(size) + size;
+}
+
+static inline unsigned char * writeVarint(unsigned char * p, uint64_t value) {
+  while (value >= 0x80) {
+    *p++ = uint8_t(value) | 0x80;
+    value >>= 7;
+  }
+  *p++ = uint8_t(value);
+  return p;
+}
+
+static inline unsigned char * writeScalarField(unsigned char * p, uint8_t tag, uint64_t value) {
+  if (value) {
+    *p++ = tag;
+    p = writeVarint(p, value);
+  }
+  return p;
+}
+
+static inline unsigned char * writeMessageTag(unsigned char * p, uint8_t tag, size_t size) {
+  *p++ = tag;
+  return writeVarint(p, size);
+}
+
+enum : uint8_t {
+  TagPreSegmentID               = (1 << 3) | 0,
+  TagPreSegmentIntersectionSize = (2 << 3) | 0,
+  TagPostSegmentSupports        = (1 << 3) | 2,
+  TagPostSegmentID              = (2 << 3) | 0,
+  TagPostSegmentOverlapSize     = (3 << 3) | 0,
+  TagPostSegmentCanSpawn        = (4 << 3) | 0,
+  TagEntryPostSegments          = (1 << 3) | 2,   // SpawnMapEntry and RegionGraphEntry
+  TagMapKey                     = (1 << 3) | 0,
+  TagMapValue                   = (2 << 3) | 2,
+  TagSpawnTableSpawnMap         = (1 << 3) | 2,
+  TagSpawnTableRegionGraph      = (2 << 3) | 2,
+  TagSpawnTableVersion          = (3 << 3) | 0,
+  TagSpawnTablePostSegments     = (4 << 3) | 2
+};
+
+void CFlatSpawnTableData::WriteSpawnTable(std::vector<unsigned char> & buffer, bool sharedPosts) const {
+  // Overlap size and supports of a post-side segment are written either once into
+  // postSegments or with every counterpart, so their size is computed once.
+  std::vector<uint32_t> postSizes(postIDs.size());
+  for (size_t post = 0; post < postIDs.size(); ++post) {
+    size_t size = scalarFieldSize(postOverlapSizes[post]);
+    for (uint32_t s = postOffsets[post]; s < postOffsets[post + 1]; ++s) {
+      size += messageFieldSize(scalarFieldSize(supportIDs[s]) + scalarFieldSize(supportSizes[s]));
+    }
+    postSizes[post] = uint32_t(size);
+  }
+  auto counterpartSize = [&](uint32_t c) -> size_t {
+    const uint32_t post = counterpartPosts[c];
+    return scalarFieldSize(postIDs[post]) + (counterpartCanSpawn[c] ? 2 : 0) + (sharedPosts ? 0 : postSizes[post]);
+  };
+
+  // Map entries always carry key and value, even if they are 0 or empty
+  std::vector<size_t> preSizes(preIDs.size());
+  size_t total = 0;
+  for (size_t pre = 0; pre < preIDs.size(); ++pre) {
+    size_t size = 0;
+    for (uint32_t c = preOffsets[pre]; c < preOffsets[pre + 1]; ++c) {
+      size += messageFieldSize(counterpartSize(c));
+    }
+    preSizes[pre] = size;
+    total += messageFieldSize(1 + varintSize(preIDs[pre]) + messageFieldSize(size));
+  }
+  std::vector<size_t> graphSizes(graphIDs.size());
+  for (size_t graph = 0; graph < graphIDs.size(); ++graph) {
+    size_t size = 0;
+    for (uint32_t n = graphOffsets[graph]; n < graphOffsets[graph + 1]; ++n) {
+      size += messageFieldSize(scalarFieldSize(graphNeighbors[n]));
+    }
+    graphSizes[graph] = size;
+    total += messageFieldSize(1 + varintSize(graphIDs[graph]) + messageFieldSize(size));
+  }
+  const uint32_t version = spawnTableVersion(*this, sharedPosts);
+  total += scalarFieldSize(version);
+  if (sharedPosts) {
+    for (size_t post = 0; post < postIDs.size(); ++post) {
+      total += messageFieldSize(scalarFieldSize(postIDs[post]) + postSizes[post]);
+    }
+  }
+
+  buffer.resize(total);
+  unsigned char * p = buffer.data();
+
+  // Fields of PostSegment in field number order: supports, id, overlap size, canSpawn
+  auto writePostSegment = [&](unsigned char * target, uint8_t tag, uint32_t post, bool details, uint8_t canSpawn) {
+    target = writeMessageTag(target, tag, scalarFieldSize(postIDs[post]) + (canSpawn ? 2 : 0) + (details ? postSizes[post] : 0));
+    if (details) {
+      for (uint32_t s = postOffsets[post]; s < postOffsets[post + 1]; ++s) {
+        target = writeMessageTag(target, TagPostSegmentSupports, scalarFieldSize(supportIDs[s]) + scalarFieldSize(supportSizes[s]));
+        target = writeScalarField(target, TagPreSegmentID, supportIDs[s]);
+        target = writeScalarField(target, TagPreSegmentIntersectionSize, supportSizes[s]);
+      }
+    }
+    target = writeScalarField(target, TagPostSegmentID, postIDs[post]);
+    if (details) {
+      target = writeScalarField(target, TagPostSegmentOverlapSize, postOverlapSizes[post]);
+    }
+    return writeScalarField(target, TagPostSegmentCanSpawn, canSpawn);
+  };
+
+  for (size_t pre = 0; pre < preIDs.size(); ++pre) {
+    p = writeMessageTag(p, TagSpawnTableSpawnMap, 1 + varintSize(preIDs[pre]) + messageFieldSize(preSizes[pre]));
+    *p++ = TagMapKey;
+    p = writeVarint(p, preIDs[pre]);
+    p = writeMessageTag(p, TagMapValue, preSizes[pre]);
+    for (uint32_t c = preOffsets[pre]; c < preOffsets[pre + 1]; ++c) {
+      p = writePostSegment(p, TagEntryPostSegments, counterpartPosts[c], !sharedPosts, counterpartCanSpawn[c] ? 1 : 0);
+    }
+  }
+
+  for (size_t graph = 0; graph < graphIDs.size(); ++graph) {
+    p = writeMessageTag(p, TagSpawnTableRegionGraph, 1 + varintSize(graphIDs[graph]) + messageFieldSize(graphSizes[graph]));
+    *p++ = TagMapKey;
+    p = writeVarint(p, graphIDs[graph]);
+    p = writeMessageTag(p, TagMapValue, graphSizes[graph]);
+    for (uint32_t n = graphOffsets[graph]; n < graphOffsets[graph + 1]; ++n) {
+      p = writeMessageTag(p, TagEntryPostSegments, scalarFieldSize(graphNeighbors[n]));
+      p = writeScalarField(p, TagPostSegmentID, graphNeighbors[n]);
+    }
+  }
+
+  p = writeScalarField(p, TagSpawnTableVersion, version);
+
+  if (sharedPosts) {
+    for (uint32_t post = 0; post < postIDs.size(); ++post) {
+      p = writePostSegment(p, TagSpawnTablePostSegments, post, true, 0);
+    }
+  }
+}
+
+/*****************************************************************/
+
+template <typename T>
+static const T * sectionPointer(const unsigned char * buffer, size_t length, const CFlatSpawnTableHeader & header, FlatSpawnTableSection section, uint64_t count) {
+  const uint64_t offset = header.sectionOffsets[section];
+  if (offset < sizeof(CFlatSpawnTableHeader) || offset % 8 != 0 || offset > length || count > (length - offset) / sizeof(T)) {
+    throw std::string("Flat spawn table section out of bounds.");
+  }
+  return reinterpret_cast<const T *>(buffer + offset);
+}
+
+// CSR offsets have to start at 0, never decrease and end at valueCount
+static void checkOffsets(const uint32_t * offsets, size_t count, size_t valueCount) {
+  if (offsets[0] != 0 || offsets[count] != valueCount) {
+    throw std::string("Flat spawn table offsets are corrupt.");
+  }
+  for (size_t i = 0; i < count; ++i) {
+    if (offsets[i] > offsets[i + 1]) {
+      throw std::string("Flat spawn table offsets are corrupt.");
+    }
+  }
+}
+
+// Flat versions a view of the ID width reads
+static bool isViewVersion(uint32_t version, uint32_t) {
+  return version == FLAT_SPAWN_TABLE_VERSION || version == FLAT_SPAWN_TABLE_VERSION_PACKED;
+}
+
+static bool isViewVersion(uint32_t version, uint64_t) {
+  return version == FLAT_SPAWN_TABLE_VERSION_64;
+}
+
+static std::string viewVersions(uint32_t) {
+  return std::to_string(FLAT_SPAWN_TABLE_VERSION) + " or " + std::to_string(FLAT_SPAWN_TABLE_VERSION_PACKED);
+}
+
+static std::string viewVersions(uint64_t) {
+  return std::to_string(FLAT_SPAWN_TABLE_VERSION_64);
+}
+
+// Group varint lists of packed tables, which only hold 32-bit IDs
+static void decodeIDList(const unsigned char * p, std::vector<uint32_t> & ids) {
+  decodeGroupVarintList(p, ids);
+}
+
+static void decodeIDList(const unsigned char *, std::vector<uint64_t> &) {
+  throw std::string("Packed flat spawn tables hold 32-bit IDs only.");
+}
+
+template <typename ID>
+bool CFlatSpawnTableViewT<ID>::IsFlatSpawnTable(const unsigned char * buffer, size_t length) {
+  return length >= sizeof(CFlatSpawnTableHeader) && memcmp(buffer, FLAT_SPAWN_TABLE_MAGIC, sizeof(FLAT_SPAWN_TABLE_MAGIC)) == 0;
+}
+
+template <typename ID>
+bool CFlatSpawnTableViewT<ID>::HasWideIDs(const unsigned char * buffer, size_t length) {
+  uint32_t version;
+  if (!IsFlatSpawnTable(buffer, length)) {
+    return false;
+  }
+  memcpy(&version, buffer + offsetof(CFlatSpawnTableHeader, version), sizeof(version));
+  return version == FLAT_SPAWN_TABLE_VERSION_64;
+}
+
+template <typename ID>
+CFlatSpawnTableViewT<ID>::CFlatSpawnTableViewT() :
+  packed(false), preCount(0), counterpartCount(0), postCount(0), supportCount(0), graphCount(0), neighborCount(0),
+  preIDs(nullptr), preOffsets(nullptr), counterpartPosts(nullptr), counterpartCanSpawn(nullptr),
+  postIDs(nullptr), postOverlapSizes(nullptr), postOffsets(nullptr), supportIDs(nullptr), supportSizes(nullptr),
+  graphIDs(nullptr), graphOffsets(nullptr), graphNeighbors(nullptr),
+  counterpartStream(nullptr), supportStream(nullptr), neighborStream(nullptr)
+{
+}
+
+template <typename ID>
+CFlatSpawnTableViewT<ID>::CFlatSpawnTableViewT(const unsigned char * buffer, size_t length) : CFlatSpawnTableViewT() {
+  if (!IsFlatSpawnTable(buffer, length)) {
+    throw std::string("Not a flat spawn table.");
+  }
+  if (reinterpret_cast<uintptr_t>(buffer) % 8 != 0) {
+    throw std::string("Flat spawn table buffer has to be 8-byte aligned.");
+  }
+
+  const CFlatSpawnTableHeader & header = *reinterpret_cast<const CFlatSpawnTableHeader *>(buffer);
+  if (!isViewVersion(header.version, ID())) {
+    throw std::string("Flat spawn table version is ") + std::to_string(header.version) + ", but " + viewVersions(ID()) + " expected!";
+  }
+  if (header.preCount >= length || header.postCount >= length || header.graphCount >= length) {
+    throw std::string("Flat spawn table section out of bounds.");
+  }
+
+  packed = (header.version == FLAT_SPAWN_TABLE_VERSION_PACKED);
+  preCount = size_t(header.preCount);
+  counterpartCount = size_t(header.counterpartCount);
+  postCount = size_t(header.postCount);
+  supportCount = size_t(header.supportCount);
+  graphCount = size_t(header.graphCount);
+  neighborCount = size_t(header.neighborCount);
+
+  preIDs = sectionPointer<ID>(buffer, length, header, PreIDs, preCount);
+  preOffsets = sectionPointer<uint32_t>(buffer, length, header, PreOffsets, preCount + 1);
+  postIDs = sectionPointer<ID>(buffer, length, header, PostIDs, postCount);
+  postOverlapSizes = sectionPointer<uint32_t>(buffer, length, header, PostOverlapSizes, postCount);
+  postOffsets = sectionPointer<uint32_t>(buffer, length, header, PostOffsets, postCount + 1);
+  graphIDs = sectionPointer<ID>(buffer, length, header, GraphIDs, graphCount);
+  graphOffsets = sectionPointer<uint32_t>(buffer, length, header, GraphOffsets, graphCount + 1);
+
+  if (packed) {
+    loadStreams(buffer, length);
+    return;
+  }
+
+  counterpartPosts = sectionPointer<uint32_t>(buffer, length, header, CounterpartPosts, counterpartCount);
+  counterpartCanSpawn = sectionPointer<uint8_t>(buffer, length, header, CounterpartCanSpawn, counterpartCount);
+  supportIDs = sectionPointer<ID>(buffer, length, header, SupportIDs, supportCount);
+  supportSizes = sectionPointer<uint32_t>(buffer, length, header, SupportSizes, supportCount);
+  graphNeighbors = sectionPointer<ID>(buffer, length, header, GraphNeighbors, neighborCount);
+
+  checkOffsets(preOffsets, preCount, counterpartCount);
+  checkOffsets(postOffsets, postCount, supportCount);
+  checkOffsets(graphOffsets, graphCount, neighborCount);
+  for (size_t c = 0; c < counterpartCount; ++c) {
+    if (counterpartPosts[c] >= postCount) {
+      throw std::string("Flat spawn table counterparts are corrupt.");
+    }
+  }
+}
+
+// Bounds of the streams of a packed table, and every list decoded once, so that
+// queries can decode them without checks
+template <typename ID>
+void CFlatSpawnTableViewT<ID>::loadStreams(const unsigned char * buffer, size_t length) {
+  const CFlatSpawnTableHeader & header = *reinterpret_cast<const CFlatSpawnTableHeader *>(buffer);
+  checkOffsets(preOffsets, preCount, preOffsets[preCount]);
+  checkOffsets(postOffsets, postCount, postOffsets[postCount]);
+  checkOffsets(graphOffsets, graphCount, graphOffsets[graphCount]);
+  counterpartStream = sectionPointer<uint8_t>(buffer, length, header, CounterpartPosts, uint64_t(preOffsets[preCount]) + GROUP_VARINT_PADDING);
+  supportStream = sectionPointer<uint8_t>(buffer, length, header, SupportIDs, uint64_t(postOffsets[postCount]) + GROUP_VARINT_PADDING);
+  neighborStream = sectionPointer<uint8_t>(buffer, length, header, GraphNeighbors, uint64_t(graphOffsets[graphCount]) + GROUP_VARINT_PADDING);
+
+  std::vector<uint32_t> values;
+  for (size_t pre = 0; pre < preCount; ++pre) {
+    decodeGroupVarintList(counterpartStream + preOffsets[pre], values, counterpartStream + preOffsets[pre + 1]);
+    uint64_t post = 0;
+    for (uint32_t value : values) {
+      post += value >> 1;
+    }
+    if (!values.empty() && post >= postCount) {
+      throw std::string("Flat spawn table counterparts are corrupt.");
+    }
+  }
+  for (size_t post = 0; post < postCount; ++post) {
+    decodeGroupVarintList(supportStream + postOffsets[post], values, supportStream + postOffsets[post + 1]);
+    if (values.size() % 2 != 0) {
+      throw std::string("Flat spawn table supports are corrupt.");
+    }
+  }
+  for (size_t graph = 0; graph < graphCount; ++graph) {
+    decodeGroupVarintList(neighborStream + graphOffsets[graph], values, neighborStream + graphOffsets[graph + 1]);
+  }
+}
+
+/*****************************************************************/
+
+template <typename ID>
+void CFlatSpawnTableViewT<ID>::GetCounterparts(size_t pre, std::vector<uint32_t> & posts, std::vector<uint8_t> & canSpawn) const {
+  if (!packed) {
+    posts.assign(counterpartPosts + preOffsets[pre], counterpartPosts + preOffsets[pre + 1]);
+    canSpawn.assign(counterpartCanSpawn + preOffsets[pre], counterpartCanSpawn + preOffsets[pre + 1]);
+    return;
+  }
+  decodeGroupVarintList(counterpartStream + preOffsets[pre], posts);
+  canSpawn.resize(posts.size());
+  uint32_t post = 0;
+  for (size_t i = 0; i < posts.size(); ++i) {
+    canSpawn[i] = uint8_t(posts[i] & 1);
+    post += posts[i] >> 1;
+    posts[i] = post;
+  }
+}
+
+template <typename ID>
+void CFlatSpawnTableViewT<ID>::GetSupports(size_t post, std::vector<ID> & ids, std::vector<uint32_t> & sizes) const {
+  if (!packed) {
+    ids.assign(supportIDs + postOffsets[post], supportIDs + postOffsets[post + 1]);
+    sizes.assign(supportSizes + postOffsets[post], supportSizes + postOffsets[post + 1]);
+    return;
+  }
+  decodeIDList(supportStream + postOffsets[post], ids);
+  const size_t count = ids.size() / 2;
+  sizes.assign(ids.begin() + count, ids.end());
+  ids.resize(count);
+  ID id = 0;
+  for (size_t i = 0; i < count; ++i) {
+    id += ids[i];
+    ids[i] = id;
+  }
+}
+
+template <typename ID>
+void CFlatSpawnTableViewT<ID>::GetNeighbors(size_t graph, std::vector<ID> & neighbors) const {
+  if (!packed) {
+    neighbors.assign(graphNeighbors + graphOffsets[graph], graphNeighbors + graphOffsets[graph + 1]);
+    return;
+  }
+  decodeIDList(neighborStream + graphOffsets[graph], neighbors);
+  ID neighbor = graphIDs[graph];
+  for (size_t i = 0; i < neighbors.size(); ++i) {
+    neighbor += neighbors[i];
+    neighbors[i] = neighbor;
+  }
+}
+
+template struct CFlatSpawnTableViewT<uint32_t>;
+template struct CFlatSpawnTableViewT<uint64_t>;
@@ -0,0 +1,38 @@
+#include <string>
+
+#include "LZMA.h"
+
+/*****************************************************************/
+
+CLZMADecoder::CLZMADecoder(const CBufferView &compressed) : ended_(false) {
+  lzma_stream init = LZMA_STREAM_INIT;
+  stream_ = init;
+  if (lzma_alone_decoder(&stream_, UINT64_MAX) != LZMA_OK) {
+    throw std::string("Could not initialize LZMA decoder.");
+  }
+  stream_.next_in = compressed.data;
+  stream_.avail_in = compressed.length;
+}
+
+CLZMADecoder::~CLZMADecoder() {
+  lzma_end(&stream_);
+}
+
+size_t CLZMADecoder::Read(unsigned char * out, size_t length) {
+  if (ended_) {
+    return 0;
+  }
+  stream_.next_out = out;
+  stream_.avail_out = length;
+
+  lzma_ret ret = LZMA_OK;
+  while (stream_.avail_out > 0 && (ret = lzma_code(&stream_, LZMA_FINISH)) == LZMA_OK) {
+  }
+  ended_ = (ret != LZMA_OK);
+
+  // LZMA_BUF_ERROR: the data ended early, which the caller sees from the returned length
+  if (ret != LZMA_OK && ret != LZMA_STREAM_END && ret != LZMA_BUF_ERROR) {
+    throw std::string("LZMA decompression failed.");
+  }
+  return length - stream_.avail_out;
+}
@@ -0,0 +1,297 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include "MetadataReader.h"
+
+/*****************************************************************/
+
+static const char     METADATA_MAGIC[4] = { 'S', 'P', 'M', 'D' };
+static const uint32_t METADATA_VERSION = 1;
+
+/*****************************************************************/
+
+// Minimal cursor over JSON text, just enough to read the flat metadata object
+class CJSONCursor {
+private:
+  const char * p_;
+  const char * end_;
+
+  void fail() const {
+    throw(std::string("Malformed metadata.json."));
+  }
+
+public:
+  explicit CJSONCursor(const CBufferView &buffer) :
+    p_(reinterpret_cast<const char *>(buffer.data)),
+    end_(reinterpret_cast<const char *>(buffer.data) + buffer.length)
+  {
+  }
+
+  void SkipSpace() {
+    while (p_ < end_ && (*p_ == ' ' || *p_ == '\t' || *p_ == '\n' || *p_ == '\r')) {
+      ++p_;
+    }
+  }
+
+  // Skips whitespace and consumes c if it comes next
+  bool Consume(char c) {
+    SkipSpace();
+    if (p_ < end_ && *p_ == c) {
+      ++p_;
+      return true;
+    }
+    return false;
+  }
+
+  void Expect(char c) {
+    if (!Consume(c)) {
+      fail();
+    }
+  }
+
+  // Contents of the string that comes next, escape sequences are left as they are
+  void ReadString(const char * &str, size_t &length) {
+    Expect('"');
+    str = p_;
+    while (p_ < end_ && *p_ != '"') {
+      p_ += (*p_ == '\\') ? 2 : 1;
+    }
+    if (p_ >= end_) {
+      fail();
+    }
+    length = size_t(p_ - str);
+    ++p_;
+  }
+
+  int64_t ReadInteger() {
+    SkipSpace();
+    const char * begin = p_;
+    bool negative = (p_ < end_ && *p_ == '-');
+    if (negative) {
+      ++p_;
+    }
+    if (p_ >= end_ || *p_ < '0' || *p_ > '9') {
+      fail();
+    }
+    int64_t value = 0;
+    while (p_ < end_ && *p_ >= '0' && *p_ <= '9') {
+      value = value * 10 + (*p_++ - '0');
+    }
+    if (p_ < end_ && (*p_ == '.' || *p_ == 'e' || *p_ == 'E')) {
+      // Rare, so strtod on a bounded copy
+      while (p_ < end_ && (strchr("0123456789.eE+-", *p_) != nullptr)) {
+        ++p_;
+      }
+      char number[64];
+      const size_t length = std::min(size_t(p_ - begin), sizeof(number) - 1);
+      memcpy(number, begin, length);
+      number[length] = '\0';
+      return int64_t(strtod(number, nullptr));
+    }
+    return negative ? -value : value;
+  }
+
+  vmml::Vector<3, int64_t> ReadVector3() {
+    Expect('[');
+    int64_t x = ReadInteger();
+    Expect(',');
+    int64_t y = ReadInteger();
+    Expect(',');
+    int64_t z = ReadInteger();
+    Expect(']');
+    return vmml::Vector<3, int64_t>(x, y, z);
+  }
+
+  void SkipValue() {
+    SkipSpace();
+    if (p_ >= end_) {
+      fail();
+    }
+    if (*p_ == '"') {
+      const char * str;
+      size_t length;
+      ReadString(str, length);
+    } else if (*p_ == '{' || *p_ == '[') {
+      const char close = (*p_ == '{') ? '}' : ']';
+      ++p_;
+      if (Consume(close)) {
+        return;
+      }
+      do {
+        if (close == '}') {
+          const char * key;
+          size_t length;
+          ReadString(key, length);
+          Expect(':');
+        }
+        SkipValue();
+      } while (Consume(','));
+      Expect(close);
+    } else {
+      // number, true, false or null
+      while (p_ < end_ && !strchr(",]} \t\r\n", *p_)) {
+        ++p_;
+      }
+    }
+  }
+};
+
+/*****************************************************************/
+
+static inline bool keyIs(const char * key, size_t length, const char * name) {
+  return strlen(name) == length && memcmp(key, name, length) == 0;
+}
+
+// MetaDataType of a type name; names fit the short string buffer, so this does not allocate
+static MetaDataType readType(CJSONCursor &cursor) {
+  const char * str;
+  size_t length;
+  cursor.ReadString(str, length);
+  return StringToMetaDataType(std::string(str, length));
+}
+
+/*****************************************************************/
+
+void readMetadataJSON(const CBufferView &json, CMetadataFields &fields) {
+  static const char * const names[] = {
+    "physical_offset_min", "physical_offset_max", "chunk_voxel_dimensions", "voxel_resolution",
+    "resolution_units", "segment_id_type", "bounding_box_type", "size_type", "num_segments"
+  };
+  const int fieldCount = int(sizeof(names) / sizeof(names[0]));
+
+  CJSONCursor cursor(json);
+  uint32_t found = 0;
+  cursor.Expect('{');
+  if (!cursor.Consume('}')) {
+    do {
+      const char * key;
+      size_t length;
+      cursor.ReadString(key, length);
+      cursor.Expect(':');
+
+      int field = 0;
+      while (field < fieldCount && !keyIs(key, length, names[field])) {
+        ++field;
+      }
+      switch (field) {
+      case 0: fields.physicalOffsetMin = cursor.ReadVector3(); break;
+      case 1: fields.physicalOffsetMax = cursor.ReadVector3(); break;
+      case 2: fields.chunkVoxelDimensions = cursor.ReadVector3(); break;
+      case 3: fields.voxelResolution = cursor.ReadVector3(); break;
+      case 4: {
+        const char * units;
+        size_t unitsLength;
+        cursor.ReadString(units, unitsLength);
+        fields.resolutionUnits.assign(units, unitsLength);
+        break;
+      }
+      case 5: fields.segmentIdType = readType(cursor); break;
+      case 6: fields.boundingBoxType = readType(cursor); break;
+      case 7: fields.sizeType = readType(cursor); break;
+      case 8: fields.numSegments = cursor.ReadInteger(); break;
+      default: cursor.SkipValue(); break;
+      }
+      if (field < fieldCount) {
+        found |= 1u << field;
+      }
+    } while (cursor.Consume(','));
+    cursor.Expect('}');
+  }
+
+  for (int field = 0; field < fieldCount; ++field) {
+    if (!(found & (1u << field))) {
+      throw(std::string("metadata.json lacks ") + names[field] + ".");
+    }
+  }
+}
+
+/*****************************************************************/
+
+bool isMetadataBinary(const CBufferView &buffer) {
+  return buffer.length >= sizeof(METADATA_MAGIC) && memcmp(buffer.data, METADATA_MAGIC, sizeof(METADATA_MAGIC)) == 0;
+}
+
+/*****************************************************************/
+
+static MetaDataType checkType(uint8_t type) {
+  switch (MetaDataType(type)) {
+  case MetaDataType::UInt8:
+  case MetaDataType::UInt16:
+  case MetaDataType::UInt32:
+  case MetaDataType::UInt64:
+    return MetaDataType(type);
+  default:
+    throw(std::string("Unsupported type in metadata.bin."));
+  }
+}
+
+void readMetadataBinary(const CBufferView &buffer, CMetadataFields &fields) {
+  const size_t headerSize = sizeof(METADATA_MAGIC) + sizeof(uint32_t) + 13 * sizeof(int64_t) + 4;
+  if (!isMetadataBinary(buffer) || buffer.length < headerSize) {
+    throw(std::string("Malformed metadata.bin."));
+  }
+  const unsigned char * p = buffer.data + sizeof(METADATA_MAGIC);
+  uint32_t version;
+  memcpy(&version, p, sizeof(version));
+  p += sizeof(version);
+  if (version != METADATA_VERSION) {
+    throw(std::string("Unsupported metadata.bin version."));
+  }
+
+  int64_t values[13];
+  memcpy(values, p, sizeof(values));
+  p += sizeof(values);
+  fields.physicalOffsetMin = vmml::Vector<3, int64_t>(values[0], values[1], values[2]);
+  fields.physicalOffsetMax = vmml::Vector<3, int64_t>(values[3], values[4], values[5]);
+  fields.chunkVoxelDimensions = vmml::Vector<3, int64_t>(values[6], values[7], values[8]);
+  fields.voxelResolution = vmml::Vector<3, int64_t>(values[9], values[10], values[11]);
+  fields.numSegments = values[12];
+
+  fields.segmentIdType = checkType(p[0]);
+  fields.boundingBoxType = checkType(p[1]);
+  fields.sizeType = checkType(p[2]);
+  const size_t unitsLength = p[3];
+  p += 4;
+  if (buffer.length < headerSize + unitsLength) {
+    throw(std::string("Malformed metadata.bin."));
+  }
+  fields.resolutionUnits.assign(reinterpret_cast<const char *>(p), unitsLength);
+}
+
+/*****************************************************************/
+
+void writeMetadataBinary(std::vector<unsigned char> &buffer, const CMetadataFields &fields) {
+  if (fields.resolutionUnits.size() > 255) {
+    throw(std::string("resolution_units too long for metadata.bin."));
+  }
+  const int64_t values[13] = {
+    fields.physicalOffsetMin.x(), fields.physicalOffsetMin.y(), fields.physicalOffsetMin.z(),
+    fields.physicalOffsetMax.x(), fields.physicalOffsetMax.y(), fields.physicalOffsetMax.z(),
+    fields.chunkVoxelDimensions.x(), fields.chunkVoxelDimensions.y(), fields.chunkVoxelDimensions.z(),
+    fields.voxelResolution.x(), fields.voxelResolution.y(), fields.voxelResolution.z(),
+    fields.numSegments
+  };
+  const unsigned char types[4] = {
+    uint8_t(fields.segmentIdType), uint8_t(fields.boundingBoxType), uint8_t(fields.sizeType), uint8_t(fields.resolutionUnits.size())
+  };
+
+  buffer.clear();
+  buffer.insert(buffer.end(), METADATA_MAGIC, METADATA_MAGIC + sizeof(METADATA_MAGIC));
+  const unsigned char * version = reinterpret_cast<const unsigned char *>(&METADATA_VERSION);
+  buffer.insert(buffer.end(), version, version + sizeof(METADATA_VERSION));
+  const unsigned char * data = reinterpret_cast<const unsigned char *>(values);
+  buffer.insert(buffer.end(), data, data + sizeof(values));
+  buffer.insert(buffer.end(), types, types + sizeof(types));
+  buffer.insert(buffer.end(), fields.resolutionUnits.begin(), fields.resolutionUnits.end());
+}
+
+/*****************************************************************/
+
+void readMetadata(const CBufferView &buffer, CMetadataFields &fields) {
+  if (isMetadataBinary(buffer)) {
+    readMetadataBinary(buffer, fields);
+  } else {
+    readMetadataJSON(buffer, fields);
+  }
+}
@@ -0,0 +1,78 @@
+#include <algorithm>
+
+#include "PaletteSegmentation.h"
+
+/*****************************************************************/
+
+void CPaletteSegmentation::appendBlock(const std::vector<uint32_t> &values) {
+  CBlock block;
+  block.indexBegin = indices_.size();
+  block.paletteBegin = uint32_t(palette_.size());
+
+  std::vector<uint32_t> palette(values);
+  std::sort(palette.begin(), palette.end());
+  palette.erase(std::unique(palette.begin(), palette.end()), palette.end());
+  palette_.insert(palette_.end(), palette.begin(), palette.end());
+
+  block.bits = 0;
+  while (block.bits < 32 && (uint64_t(1) << block.bits) < palette.size()) {
+    block.bits = block.bits ? 2 * block.bits : 1;
+  }
+  blocks_.push_back(block);
+  if (block.bits == 0) {
+    return;
+  }
+
+  const size_t perWord = 64 / block.bits;
+  indices_.resize(indices_.size() + (values.size() + perWord - 1) / perWord, 0);
+  uint64_t * words = indices_.data() + block.indexBegin;
+  for (size_t i = 0; i < values.size(); ++i) {
+    const uint64_t index = uint64_t(std::lower_bound(palette.begin(), palette.end(), values[i]) - palette.begin());
+    words[i / perWord] |= index << ((i % perWord) * block.bits);
+  }
+}
+
+size_t CPaletteSegmentation::GetByteSize() const {
+  return blocks_.size() * sizeof(CBlock) + palette_.size() * sizeof(uint32_t) + indices_.size() * sizeof(uint64_t);
+}
+
+vmml::AABB<int64_t> CPaletteSegmentation::GetBlockBounds(int64_t bx, int64_t by, int64_t bz) const {
+  const vmml::Vector<3, int64_t> min(bounds_.getMin().x() + bx * BLOCK_SIZE, bounds_.getMin().y() + by * BLOCK_SIZE, bounds_.getMin().z() + bz * BLOCK_SIZE);
+  const vmml::Vector<3, int64_t> max(std::min(min.x() + BLOCK_SIZE, bounds_.getMax().x()),
+                                     std::min(min.y() + BLOCK_SIZE, bounds_.getMax().y()),
+                                     std::min(min.z() + BLOCK_SIZE, bounds_.getMax().z()));
+  return vmml::AABB<int64_t>(min, max);
+}
+
+uint32_t CPaletteSegmentation::operator()(int64_t x, int64_t y, int64_t z) const {
+  uint32_t segID;
+  DecodeRow(x, y, z, 1, &segID);
+  return segID;
+}
+
+void CPaletteSegmentation::DecodeRow(int64_t x, int64_t y, int64_t z, int64_t length, uint32_t * out) const {
+  const vmml::Vector<3, int64_t> first = BlockOf(x, y, z);
+  for (int64_t bx = first.x(); length > 0; ++bx) {
+    const CBlock &block = blocks_[blockIndex(bx, first.y(), first.z())];
+    const vmml::AABB<int64_t> bounds = GetBlockBounds(bx, first.y(), first.z());
+    const int64_t count = std::min(length, bounds.getMax().x() - x);
+
+    if (block.bits == 0) {
+      std::fill(out, out + count, palette_[block.paletteBegin]);
+    } else {
+      const vmml::Vector<3, int64_t> dims = bounds.getDimension();
+      const size_t perWord = 64 / block.bits;
+      const uint64_t mask = (uint64_t(1) << block.bits) - 1;
+      const uint64_t * words = indices_.data() + block.indexBegin;
+      const uint32_t * palette = palette_.data() + block.paletteBegin;
+      size_t i = size_t((x - bounds.getMin().x()) + (y - bounds.getMin().y()) * dims.x() + (z - bounds.getMin().z()) * dims.x() * dims.y());
+      for (int64_t n = 0; n < count; ++n, ++i) {
+        out[n] = palette[(words[i / perWord] >> ((i % perWord) * block.bits)) & mask];
+      }
+    }
+
+    out += count;
+    x += count;
+    length -= count;
+  }
+}
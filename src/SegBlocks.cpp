@@ -0,0 +1,104 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "BlockSegmentation.h"
+#include "ChunkLoader.h"
+#include "MetadataReader.h"
+
+/*****************************************************************/
+
+// Converts the segmentation of chunks to the block format of BlockSegmentation.h:
+//   segblocks [-b x,y,z] [-m] <chunk>...
+// Chunks are local directories laid out as in the bucket; segmentation.blocks is written
+// next to their segmentation.lzma (or uncompressed segmentation). Blocks default to 32^3.
+// With -m, metadata.json is also converted to its binary sidecar metadata.bin.
+
+static void usage() {
+  std::cerr << "usage: segblocks [-b x,y,z] [-m] <chunk>...\n";
+}
+
+static void writeFile(const std::string &filename, const std::vector<unsigned char> &buffer) {
+  std::ofstream f(filename, std::ofstream::binary);
+  f.write(reinterpret_cast<const char *>(buffer.data()), std::streamsize(buffer.size()));
+  if (!f) {
+    throw std::string("Could not write " + filename);
+  }
+  std::cout << "Wrote " << filename << " (" << buffer.size() << " bytes)\n";
+}
+
+// Always from metadata.json, so a stale metadata.bin is replaced
+static void convertMetadata(const std::string &dir) {
+  CMetadataFields fields;
+  readMetadataJSON(CBufferView(readFile(dir + "metadata.json")), fields);
+  std::vector<unsigned char> buffer;
+  writeMetadataBinary(buffer, fields);
+  writeFile(dir + "metadata.bin", buffer);
+}
+
+static void convertChunk(const std::string &path, const vmml::Vector<3, int64_t> &blockSize, bool metadata) {
+  const std::string dir = (path.empty() || path.back() == '/') ? path : path + "/";
+  if (metadata) {
+    convertMetadata(dir);
+  }
+
+  // A previous segmentation.blocks is loaded as well; it is read completely before it is
+  // overwritten.
+  CChunk chunk(dir);
+  const CVolume &volume = chunk.GetVolume();
+
+  const vmml::Vector<3, int64_t> dimensions = volume.GetResidentBounds().getDimension();
+  const size_t bytes = volume.GetSegmentationByteSize();
+  const uint32_t voxelSize = uint32_t(bytes / size_t(dimensions.x() * dimensions.y() * dimensions.z()));
+  const unsigned char * segmentation = volume.GetSegmentationView<unsigned char>().Ptr(0, 0, 0); // chunks are fully resident
+
+  std::vector<unsigned char> buffer;
+  writeBlockSegmentation(buffer, CBufferView(segmentation, bytes), dimensions, voxelSize, blockSize);
+
+  writeFile(dir + "segmentation.blocks", buffer);
+}
+
+int main(int argc, char* argv[]) {
+  vmml::Vector<3, int64_t> blockSize(32, 32, 32);
+  bool metadata = false;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "b:m")) != -1) {
+    switch (opt) {
+    case 'b': {
+      long x, y, z;
+      if (sscanf(optarg, "%ld,%ld,%ld", &x, &y, &z) != 3 || x < 1 || y < 1 || z < 1) {
+        usage();
+        return 1;
+      }
+      blockSize = vmml::Vector<3, int64_t>(x, y, z);
+      break;
+    }
+    case 'm':
+      metadata = true;
+      break;
+    default:
+      usage();
+      return 1;
+    }
+  }
+  if (argc - optind < 1) {
+    usage();
+    return 1;
+  }
+
+  try {
+    for (int i = optind; i < argc; ++i) {
+      convertChunk(argv[i], blockSize, metadata);
+    }
+  } catch (const std::string &err) {
+    std::cerr << err << "\n";
+    return 1;
+  }
+  return 0;
+}
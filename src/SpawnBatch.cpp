@@ -0,0 +1,267 @@
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ChunkCache.h"
+#include "SpawnSetGenerator.h"
+#include "ThreadPool.h"
+
+#include <google/protobuf/stubs/common.h>
+
+/*****************************************************************/
+
+// Generates the spawn tables of a whole dataset in one process:
+//   spawnbatch [-t threads] [-m megabytes] [-k] [-p] [-f] [-s] -i datasetdir -o outdir <tasklist>
+// The task list has one "<center> <neighbor>" pair of chunk paths per line, relative to
+// datasetdir (the (pre, post) tasks of src/python/main.py). Pairs are grouped by center
+// chunk and each center is one task on the pool; the table towards neighbor path/to/N is
+// written to <outdir>/<center>N.pb.spawn (or N.flat.spawn with -f), mirroring the blob
+// names in the bucket.
+// Loaded chunks stay resident within -m megabytes (default: half the physical memory).
+// Centers are processed along a Morton curve over the chunk grid, so consecutive tasks
+// share most of their chunks; -k keeps the order of the task list instead.
+// -p keeps loaded chunks palette encoded (CPaletteSegmentation): far less memory per
+// chunk on homogeneous data, and block-wise scans.
+// -s writes protobuf tables as version 3 (post-side segments stored once), which older
+// servers reject.
+
+struct CSpawnJob {
+  std::string               center;
+  std::vector<std::string>  neighbors;
+};
+
+static void usage() {
+  std::cerr << "usage: spawnbatch [-t threads] [-m megabytes] [-k] [-p] [-f] [-s] -i datasetdir -o outdir <tasklist>\n";
+}
+
+static std::string withSlash(const std::string &path) {
+  return (path.empty() || path.back() == '/') ? path : path + "/";
+}
+
+static void makeDirectories(const std::string &path) {
+  for (size_t pos = path.find('/', 1); pos != std::string::npos; pos = path.find('/', pos + 1)) {
+    const std::string dir = path.substr(0, pos);
+    if (mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST) {
+      throw std::string("Could not create " + dir);
+    }
+  }
+}
+
+// Jobs in order of the first task of each center
+static std::vector<CSpawnJob> readJobs(const std::string &filename) {
+  std::ifstream f(filename);
+  if (!f) {
+    throw std::string("Could not open " + filename);
+  }
+
+  std::vector<CSpawnJob> jobs;
+  std::unordered_map<std::string, size_t> jobOf;
+  std::string line;
+  while (std::getline(f, line)) {
+    std::istringstream fields(line);
+    std::string center, neighbor;
+    if (!(fields >> center)) {
+      continue;
+    }
+    if (!(fields >> neighbor)) {
+      throw std::string("Invalid task: " + line);
+    }
+
+    center = withSlash(center);
+    auto inserted = jobOf.insert(std::make_pair(center, jobs.size()));
+    if (inserted.second) {
+      jobs.push_back(CSpawnJob());
+      jobs.back().center = center;
+    }
+    jobs[inserted.first->second].neighbors.push_back(withSlash(neighbor));
+  }
+  return jobs;
+}
+
+// Interleaves the lower 21 bits of x, y and z
+static uint64_t mortonCode(uint64_t x, uint64_t y, uint64_t z) {
+  uint64_t code = 0;
+  for (int bit = 0; bit < 21; ++bit) {
+    code |= ((x >> bit) & 1) << (3 * bit);
+    code |= ((y >> bit) & 1) << (3 * bit + 1);
+    code |= ((z >> bit) & 1) << (3 * bit + 2);
+  }
+  return code;
+}
+
+// Sorts jobs by the Morton code of their center's position in the chunk grid. Grid
+// coordinates are the ranks of the chunk offsets along each axis, which does not
+// depend on chunk size or overlap.
+static void sortByMortonOrder(std::vector<CSpawnJob> &jobs, const std::string &datasetdir) {
+  std::vector<vmml::Vector<3, int64_t>> offsets;
+  std::vector<int64_t> axisOffsets[3];
+  for (const CSpawnJob &job : jobs) {
+    offsets.push_back(readChunkOffset(withSlash(datasetdir) + job.center));
+    for (int axis = 0; axis < 3; ++axis) {
+      axisOffsets[axis].push_back(offsets.back()[axis]);
+    }
+  }
+  for (int axis = 0; axis < 3; ++axis) {
+    std::sort(axisOffsets[axis].begin(), axisOffsets[axis].end());
+    axisOffsets[axis].erase(std::unique(axisOffsets[axis].begin(), axisOffsets[axis].end()), axisOffsets[axis].end());
+  }
+
+  std::vector<std::pair<uint64_t, size_t>> order;
+  for (size_t j = 0; j < jobs.size(); ++j) {
+    uint64_t cell[3];
+    for (int axis = 0; axis < 3; ++axis) {
+      cell[axis] = uint64_t(std::lower_bound(axisOffsets[axis].begin(), axisOffsets[axis].end(), offsets[j][axis]) - axisOffsets[axis].begin());
+    }
+    order.push_back(std::make_pair(mortonCode(cell[0], cell[1], cell[2]), j));
+  }
+  std::sort(order.begin(), order.end());
+
+  std::vector<CSpawnJob> sorted;
+  for (const auto &entry : order) {
+    sorted.push_back(std::move(jobs[entry.second]));
+  }
+  jobs.swap(sorted);
+}
+
+/*****************************************************************/
+
+int main(int argc, char* argv[]) {
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+  unsigned int threadCount = std::max(1u, std::thread::hardware_concurrency());
+  size_t cacheBudget = size_t(sysconf(_SC_PHYS_PAGES)) * size_t(sysconf(_SC_PAGE_SIZE)) / 2;
+  bool keepOrder = false;
+  bool palette = false;
+  bool flat = false;
+  bool sharedPosts = false;
+  std::string datasetdir, outdir;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "t:m:kpfsi:o:")) != -1) {
+    switch (opt) {
+    case 't':
+      threadCount = unsigned(std::max(1, atoi(optarg)));
+      break;
+    case 'm':
+      cacheBudget = size_t(std::max(1, atoi(optarg))) << 20;
+      break;
+    case 'k':
+      keepOrder = true;
+      break;
+    case 'p':
+      palette = true;
+      break;
+    case 'f':
+      flat = true;
+      break;
+    case 's':
+      sharedPosts = true;
+      break;
+    case 'i':
+      datasetdir = optarg;
+      break;
+    case 'o':
+      outdir = optarg;
+      break;
+    default:
+      usage();
+      return 1;
+    }
+  }
+  if (argc - optind != 1 || datasetdir.empty() || outdir.empty()) {
+    usage();
+    return 1;
+  }
+  outdir = withSlash(outdir);
+
+  std::vector<CSpawnJob> jobs;
+  try {
+    jobs = readJobs(argv[optind]);
+    if (!keepOrder) {
+      sortByMortonOrder(jobs, datasetdir);
+    }
+  } catch (const std::string &err) {
+    std::cerr << err << "\n";
+    return 1;
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << "\n";
+    return 1;
+  }
+
+  CChunkCache cache(datasetdir, cacheBudget, palette);
+  std::mutex outputMutex;
+  std::atomic<size_t> processed(0);
+  std::atomic<size_t> failed(0);
+
+  {
+    CThreadPool pool(threadCount);
+    for (size_t j = 0; j < jobs.size(); ++j) {
+      pool.Submit([&, j]() {
+        const CSpawnJob &job = jobs[j];
+        try {
+          std::shared_ptr<const CChunk> center = cache.Get(job.center);
+          std::vector<std::shared_ptr<const CChunk>> neighbors;
+          std::vector<const CVolume *> neighborVolumes;
+          for (const std::string &path : job.neighbors) {
+            neighbors.push_back(cache.Get(path));
+            neighborVolumes.push_back(&neighbors.back()->GetVolume());
+          }
+
+          // The pool already keeps every core busy, so each job runs single-threaded
+          std::vector<CFlatSpawnTableData> spawntables;
+          calcSpawnTables(spawntables, center->GetVolume(), neighborVolumes, 1);
+
+          makeDirectories(outdir + job.center);
+          std::vector<unsigned char> buffer;
+          for (size_t i = 0; i < spawntables.size(); ++i) {
+            if (flat) {
+              spawntables[i].Write(buffer);
+            } else {
+              serializeSpawnTable(spawntables[i], buffer, sharedPosts);
+            }
+
+            const std::string filename = outdir + job.center + chunkName(job.neighbors[i]) + (flat ? ".flat.spawn" : ".pb.spawn");
+            std::ofstream f(filename, std::ofstream::binary);
+            f.write(reinterpret_cast<const char *>(buffer.data()), std::streamsize(buffer.size()));
+            if (!f) {
+              throw std::string("Could not write " + filename);
+            }
+          }
+
+          std::lock_guard<std::mutex> lock(outputMutex);
+          std::cout << "Processed task " << ++processed << "/" << jobs.size() << "\n";
+        } catch (const std::string &err) {
+          ++failed;
+          std::lock_guard<std::mutex> lock(outputMutex);
+          std::cerr << job.center << ": " << err << "\n";
+        } catch (const std::exception &e) {
+          ++failed;
+          std::lock_guard<std::mutex> lock(outputMutex);
+          std::cerr << job.center << ": " << e.what() << "\n";
+        }
+      });
+    }
+    pool.Wait();
+  }
+
+  google::protobuf::ShutdownProtobufLibrary();
+
+  if (failed > 0) {
+    std::cerr << failed << " of " << jobs.size() << " tasks failed.\n";
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,711 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <new>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include "GroupVarint.h"
+#include "SpawnHelper.h"
+#include "SpawnSetGenerator.h"
+#include "SpawnTableIndex.h"
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <google/protobuf/stubs/common.h>
+
+#include "../res/spawnset.pb.h"
+
+/*****************************************************************/
+
+// Benchmarks the spawner hot paths on synthetic segmentations:
+//   spawnbench [-d x,y,z] [-i 8|16|32|64] [-w] [-s segments] [-l runlength] [-o overlap]
+//              [-t threads] [-p] [-r repeats] [-q queries] [-g queries] [-k selection]
+// Two chunks of -d voxels (default 256,256,128) overlap by -o voxels (default 32) along x.
+// Both are cut into boxes -l voxels long in x (default 32), sized in y and z so that a
+// chunk holds about -s segments (default 4096); the boxes of the post chunk are shifted
+// by a quarter box in y and z, so most segments meet several counterparts. -i sets the
+// segment ID type (default 32), -w moves all IDs above 2^32 (UInt64 only, sparse
+// metadata), -p palette encodes both chunks.
+// calcSpawnTable, protobuf and flat serialization, group varint decoding of the packed
+// flat table (decodeGroupVarint, once per decoder the CPU runs, which have to agree),
+// index loading, the seed query of the
+// index (query_seeds, -q queries, default 1000) and get_seeds of SpawnHelper.h on the
+// voxels (-g queries, default 100; dense volumes of up to 32-bit IDs only) are timed
+// separately, each over -r repeats (default 5) after one untimed run. Before that, the
+// wire encoder of WriteSpawnTable is checked against the protobuf serializer for
+// versions 1 to 3; spawnbench exits with 1 if they differ. Queries select -k
+// random pre-side segments of the overlap (default 8). Every phase prints one JSON
+// object per line to stdout: best and mean seconds, throughput, bytes allocated through
+// operator new per run and peak RSS of the phase.
+
+/*****************************************************************/
+
+static std::atomic<uint64_t> allocatedBytes(0);
+static std::atomic<uint64_t> allocationCount(0);
+
+void * operator new(size_t size) {
+  allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+  void * p = malloc(size ? size : 1);
+  if (!p) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void * p) noexcept {
+  free(p);
+}
+
+/*****************************************************************/
+
+// Resets the peak RSS of the process to its current RSS, false if the kernel does not support it
+static bool resetPeakRSS() {
+  std::ofstream f("/proc/self/clear_refs");
+  f << "5";
+  f.flush();
+  return bool(f);
+}
+
+// Peak RSS in kB since the last resetPeakRSS (VmHWM), of the whole run without /proc
+static int64_t peakRSS() {
+  std::ifstream f("/proc/self/status");
+  std::string line;
+  while (std::getline(f, line)) {
+    if (line.compare(0, 6, "VmHWM:") == 0) {
+      return atoll(line.c_str() + 6);
+    }
+  }
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return int64_t(usage.ru_maxrss);
+}
+
+/*****************************************************************/
+
+struct CMeasurement {
+  double   bestSeconds;
+  double   meanSeconds;
+  uint64_t allocatedBytes;   // per run
+  uint64_t allocations;      // per run
+  int64_t  peakRSS;          // kB
+};
+
+// Runs f once untimed, then repeats times
+template <typename F>
+static CMeasurement measure(unsigned int repeats, F f) {
+  f();
+
+  resetPeakRSS();
+  const uint64_t bytesBefore = allocatedBytes.load();
+  const uint64_t countBefore = allocationCount.load();
+  double best = 0.0, total = 0.0;
+  for (unsigned int r = 0; r < repeats; ++r) {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    best = (r == 0) ? seconds : std::min(best, seconds);
+    total += seconds;
+  }
+
+  CMeasurement m;
+  m.bestSeconds = best;
+  m.meanSeconds = total / repeats;
+  m.allocatedBytes = (allocatedBytes.load() - bytesBefore) / repeats;
+  m.allocations = (allocationCount.load() - countBefore) / repeats;
+  m.peakRSS = peakRSS();
+  return m;
+}
+
+/*****************************************************************/
+
+// One flat JSON object, printed as a single line
+class CJSONLine {
+private:
+  std::ostringstream out_;
+  bool               first_;
+
+  std::ostream & key(const char * name) {
+    out_ << (first_ ? "{\"" : ",\"") << name << "\":";
+    first_ = false;
+    return out_;
+  }
+
+public:
+  CJSONLine() : first_(true) {
+    out_.precision(9);
+  }
+
+  CJSONLine & Add(const char * name, const std::string & value) { key(name) << '"' << value << '"'; return *this; }
+  CJSONLine & Add(const char * name, const char * value) { return Add(name, std::string(value)); }
+  CJSONLine & Add(const char * name, bool value) { key(name) << (value ? "true" : "false"); return *this; }
+  CJSONLine & Add(const char * name, double value) { key(name) << value; return *this; }
+  CJSONLine & Add(const char * name, int64_t value) { key(name) << value; return *this; }
+  CJSONLine & Add(const char * name, uint64_t value) { key(name) << value; return *this; }
+  CJSONLine & Add(const char * name, const vmml::Vector<3, int64_t> & value) {
+    key(name) << '[' << value.x() << ',' << value.y() << ',' << value.z() << ']';
+    return *this;
+  }
+
+  CJSONLine & Add(const CMeasurement & m) {
+    Add("seconds_best", m.bestSeconds);
+    Add("seconds_mean", m.meanSeconds);
+    Add("allocated_bytes", m.allocatedBytes);
+    Add("allocations", m.allocations);
+    Add("peak_rss_kb", m.peakRSS);
+    return *this;
+  }
+
+  void Print() {
+    std::cout << out_.str() << "}" << std::endl;
+  }
+};
+
+// Swallows what is written to it
+class CNullBuffer : public std::streambuf {
+protected:
+  int overflow(int c) override { return c; }
+  std::streamsize xsputn(const char *, std::streamsize n) override { return n; }
+};
+
+/*****************************************************************/
+
+struct CSyntheticParams {
+  vmml::Vector<3, int64_t> dims;
+  MetaDataType             idType;
+  bool                     wide;
+  int64_t                  segments;
+  int64_t                  runLength;
+  int64_t                  overlap;
+};
+
+// A chunk of the synthetic dataset, with the buffers its volume borrows
+struct CSyntheticChunk {
+  std::string                json;
+  std::vector<unsigned char> ids;
+  std::vector<unsigned char> bboxes;
+  std::vector<unsigned char> sizes;
+  std::vector<unsigned char> segmentation;
+  std::unique_ptr<CVolume>   volume;
+};
+
+static const char * typeName(MetaDataType type) {
+  switch (type) {
+  case MetaDataType::UInt8:  return "UInt8";
+  case MetaDataType::UInt16: return "UInt16";
+  case MetaDataType::UInt32: return "UInt32";
+  default:                   return "UInt64";
+  }
+}
+
+template <typename T>
+static void appendValue(std::vector<unsigned char> & buffer, T value) {
+  const unsigned char * p = reinterpret_cast<const unsigned char *>(&value);
+  buffer.insert(buffer.end(), p, p + sizeof(T));
+}
+
+template <typename T>
+static void fillSegmentation(CSyntheticChunk & chunk, const vmml::Vector<3, int64_t> & dims, int64_t originX, int64_t runLength,
+                             const std::vector<uint64_t> & rowIDs, int64_t cellsX) {
+  chunk.segmentation.resize(size_t(dims.x() * dims.y() * dims.z()) * sizeof(T));
+  T * out = reinterpret_cast<T *>(chunk.segmentation.data());
+  for (int64_t yz = 0; yz < dims.y() * dims.z(); ++yz) {
+    const uint64_t * cells = &rowIDs[size_t(yz * cellsX)];
+    for (int64_t x = 0, cell = 0; x < dims.x(); ++cell) {
+      const int64_t end = std::min(dims.x(), ((originX + x) / runLength + 1) * runLength - originX);
+      std::fill(out, out + (end - x), T(cells[cell]));
+      out += end - x;
+      x = end;
+    }
+  }
+}
+
+// Edge length in y and z of the segment boxes, so that a chunk holds about params.segments
+static int64_t cellSize(const CSyntheticParams & params) {
+  const vmml::Vector<3, int64_t> & dims = params.dims;
+  return std::max<int64_t>(1, int64_t(std::sqrt(double(dims.x() * dims.y() * dims.z()) / double(params.runLength * params.segments)) + 0.5));
+}
+
+// Chunk at voxel offset (originX, 0, 0) of the synthetic dataset. Segments are the boxes
+// of a grid of runLength x cell x cell voxels, offset by shift voxels in y and z, and are
+// numbered from 1 in x, y, z order over the boxes the chunk touches.
+static void makeChunk(CSyntheticChunk & chunk, const CSyntheticParams & params, int64_t originX, int64_t shift) {
+  const vmml::Vector<3, int64_t> & dims = params.dims;
+  const int64_t runLength = params.runLength;
+  const int64_t cell = cellSize(params);
+
+  const int64_t firstX = originX / runLength;
+  const int64_t firstYZ = shift / cell;
+  const int64_t cellsX = (originX + dims.x() - 1) / runLength - firstX + 1;
+  const int64_t cellsY = (dims.y() - 1 + shift) / cell - firstYZ + 1;
+  const int64_t cellsZ = (dims.z() - 1 + shift) / cell - firstYZ + 1;
+  const int64_t segmentCount = cellsX * cellsY * cellsZ;
+  const uint64_t idOffset = params.wide ? (uint64_t(1) << 32) : 0;
+  if ((params.idType == MetaDataType::UInt8 && segmentCount > 0xFF) ||
+      (params.idType == MetaDataType::UInt16 && segmentCount > 0xFFFF)) {
+    throw std::string("Too many segments for the segment ID type.");
+  }
+
+  // Volume bounds (inclusive) and sizes of the boxes, clipped to the chunk
+  chunk.ids.clear();
+  chunk.bboxes.clear();
+  chunk.sizes.clear();
+  if (!params.wide) {
+    // Dense arrays, entry 0 is the background
+    chunk.bboxes.resize(6 * sizeof(uint32_t));
+    chunk.sizes.resize(sizeof(uint32_t));
+  }
+  for (int64_t cz = 0; cz < cellsZ; ++cz) {
+    for (int64_t cy = 0; cy < cellsY; ++cy) {
+      for (int64_t cx = 0; cx < cellsX; ++cx) {
+        const vmml::Vector<3, int64_t> min(std::max<int64_t>(0, (firstX + cx) * runLength - originX),
+                                           std::max<int64_t>(0, (firstYZ + cy) * cell - shift),
+                                           std::max<int64_t>(0, (firstYZ + cz) * cell - shift));
+        const vmml::Vector<3, int64_t> max(std::min(dims.x(), (firstX + cx + 1) * runLength - originX) - 1,
+                                           std::min(dims.y(), (firstYZ + cy + 1) * cell - shift) - 1,
+                                           std::min(dims.z(), (firstYZ + cz + 1) * cell - shift) - 1);
+        const uint64_t id = idOffset + uint64_t((cz * cellsY + cy) * cellsX + cx + 1);
+        if (params.wide) {
+          appendValue<uint64_t>(chunk.ids, id);
+        }
+        for (int i = 0; i < 3; ++i) {
+          appendValue<uint32_t>(chunk.bboxes, uint32_t(min[i]));
+        }
+        for (int i = 0; i < 3; ++i) {
+          appendValue<uint32_t>(chunk.bboxes, uint32_t(max[i]));
+        }
+        const vmml::Vector<3, int64_t> extent = max - min + vmml::Vector<3, int64_t>(1, 1, 1);
+        appendValue<uint32_t>(chunk.sizes, uint32_t(extent.x() * extent.y() * extent.z()));
+      }
+    }
+  }
+
+  // Segment IDs of the boxes along each row
+  std::vector<uint64_t> rowIDs(size_t(dims.y() * dims.z() * cellsX));
+  for (int64_t z = 0; z < dims.z(); ++z) {
+    for (int64_t y = 0; y < dims.y(); ++y) {
+      const int64_t cy = (y + shift) / cell - firstYZ;
+      const int64_t cz = (z + shift) / cell - firstYZ;
+      for (int64_t cx = 0; cx < cellsX; ++cx) {
+        rowIDs[size_t((z * dims.y() + y) * cellsX + cx)] = idOffset + uint64_t((cz * cellsY + cy) * cellsX + cx + 1);
+      }
+    }
+  }
+  switch (params.idType) {
+  case MetaDataType::UInt8:  fillSegmentation<uint8_t>(chunk, dims, originX, runLength, rowIDs, cellsX); break;
+  case MetaDataType::UInt16: fillSegmentation<uint16_t>(chunk, dims, originX, runLength, rowIDs, cellsX); break;
+  case MetaDataType::UInt32: fillSegmentation<uint32_t>(chunk, dims, originX, runLength, rowIDs, cellsX); break;
+  default:                   fillSegmentation<uint64_t>(chunk, dims, originX, runLength, rowIDs, cellsX); break;
+  }
+
+  std::ostringstream json;
+  json << "{\"physical_offset_min\":[" << originX << ",0,0]"
+       << ",\"physical_offset_max\":[" << originX + dims.x() << "," << dims.y() << "," << dims.z() << "]"
+       << ",\"chunk_voxel_dimensions\":[" << dims.x() << "," << dims.y() << "," << dims.z() << "]"
+       << ",\"voxel_resolution\":[1,1,1],\"resolution_units\":\"nm\""
+       << ",\"segment_id_type\":\"" << typeName(params.idType) << "\""
+       << ",\"bounding_box_type\":\"UInt32\",\"size_type\":\"UInt32\""
+       << ",\"num_segments\":" << segmentCount << "}";
+  chunk.json = json.str();
+
+  const CBufferView json_view(reinterpret_cast<const unsigned char *>(chunk.json.data()), chunk.json.size());
+  std::unique_ptr<CVolumeMetadata> meta;
+  if (params.wide) {
+    meta.reset(new CVolumeMetadata(json_view, CBufferView(chunk.ids), CBufferView(chunk.bboxes), CBufferView(chunk.sizes)));
+  } else {
+    meta.reset(new CVolumeMetadata(json_view, CBufferView(chunk.bboxes), CBufferView(chunk.sizes)));
+  }
+  chunk.volume.reset(new CVolume(std::move(meta), CBufferView(chunk.segmentation)));
+}
+
+/*****************************************************************/
+
+// ToSpawnTable serialized by protobuf itself. Map entries are only written in key order,
+// as WriteSpawnTable writes them, with deterministic serialization.
+static std::string serializeWithProtobuf(const CFlatSpawnTableData & spawntable, bool sharedPosts) {
+  ew::spawner::SpawnTable message;
+  spawntable.ToSpawnTable(message, sharedPosts);
+
+  std::string bytes;
+  {
+    google::protobuf::io::StringOutputStream stream(&bytes);
+    google::protobuf::io::CodedOutputStream coded(&stream);
+    coded.SetSerializationDeterministic(true);
+    message.SerializeToCodedStream(&coded);
+  }
+  return bytes;
+}
+
+// Compares WriteSpawnTable with the protobuf serializer for the table and, unless its
+// IDs are wide already, a copy with all IDs moved above 2^32. Throws std::string on the
+// first difference, returns the versions checked.
+static std::string checkSpawnTableEncoder(const CFlatSpawnTableData & spawntable) {
+  std::vector<const CFlatSpawnTableData *> tables(1, &spawntable);
+  CFlatSpawnTableData wide;
+  if (!spawntable.HasWideIDs()) {
+    wide = spawntable;
+    for (std::vector<uint64_t> * ids : { &wide.preIDs, &wide.postIDs, &wide.supportIDs, &wide.graphIDs, &wide.graphNeighbors }) {
+      for (uint64_t & id : *ids) {
+        id += uint64_t(1) << 32;
+      }
+    }
+    tables.push_back(&wide);
+  }
+
+  std::set<uint32_t> versions;
+  std::vector<unsigned char> encoded;
+  for (const CFlatSpawnTableData * table : tables) {
+    for (bool sharedPosts : { false, true }) {
+      const uint32_t version = sharedPosts ? SPAWN_TABLE_VERSION_SHARED : table->HasWideIDs() ? SPAWN_TABLE_VERSION_64 : SPAWN_TABLE_VERSION;
+      table->WriteSpawnTable(encoded, sharedPosts);
+      const std::string expected = serializeWithProtobuf(*table, sharedPosts);
+      if (encoded.size() != expected.size() || !std::equal(encoded.begin(), encoded.end(), expected.begin(), [](unsigned char a, char b) { return a == static_cast<unsigned char>(b); })) {
+        throw std::string("WriteSpawnTable differs from the protobuf serializer for a version ") + std::to_string(version) + " table.";
+      }
+      versions.insert(version);
+    }
+  }
+
+  std::string list;
+  for (uint32_t version : versions) {
+    list += (list.empty() ? "" : ",") + std::to_string(version);
+  }
+  return list;
+}
+
+/*****************************************************************/
+
+static bool parseDims(const char * str, vmml::Vector<3, int64_t> & dims) {
+  long long x, y, z;
+  if (sscanf(str, "%lld,%lld,%lld", &x, &y, &z) != 3 || x <= 0 || y <= 0 || z <= 0) {
+    return false;
+  }
+  dims = vmml::Vector<3, int64_t>(x, y, z);
+  return true;
+}
+
+static void usage() {
+  std::cerr << "usage: spawnbench [-d x,y,z] [-i 8|16|32|64] [-w] [-s segments] [-l runlength] [-o overlap]\n"
+               "                  [-t threads] [-p] [-r repeats] [-q queries] [-g queries] [-k selection]\n";
+}
+
+int main(int argc, char* argv[]) {
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+  CSyntheticParams params;
+  params.dims = vmml::Vector<3, int64_t>(256, 256, 128);
+  params.idType = MetaDataType::UInt32;
+  params.wide = false;
+  params.segments = 4096;
+  params.runLength = 32;
+  params.overlap = 32;
+  unsigned int threadCount = 1;
+  bool palette = false;
+  unsigned int repeats = 5;
+  size_t queryCount = 1000;
+  size_t seedQueryCount = 100;
+  size_t selectionSize = 8;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "d:i:ws:l:o:t:pr:q:g:k:")) != -1) {
+    switch (opt) {
+    case 'd':
+      if (!parseDims(optarg, params.dims)) {
+        usage();
+        return 1;
+      }
+      break;
+    case 'i':
+      switch (atoi(optarg)) {
+      case 8:  params.idType = MetaDataType::UInt8; break;
+      case 16: params.idType = MetaDataType::UInt16; break;
+      case 32: params.idType = MetaDataType::UInt32; break;
+      case 64: params.idType = MetaDataType::UInt64; break;
+      default:
+        usage();
+        return 1;
+      }
+      break;
+    case 'w':
+      params.wide = true;
+      break;
+    case 's':
+      params.segments = std::max<int64_t>(1, atoll(optarg));
+      break;
+    case 'l':
+      params.runLength = std::max<int64_t>(1, atoll(optarg));
+      break;
+    case 'o':
+      params.overlap = atoll(optarg);
+      break;
+    case 't':
+      threadCount = unsigned(std::max(1, atoi(optarg)));
+      break;
+    case 'p':
+      palette = true;
+      break;
+    case 'r':
+      repeats = unsigned(std::max(1, atoi(optarg)));
+      break;
+    case 'q':
+      queryCount = size_t(std::max(1, atoi(optarg)));
+      break;
+    case 'g':
+      seedQueryCount = size_t(std::max(1, atoi(optarg)));
+      break;
+    case 'k':
+      selectionSize = size_t(std::max(1, atoi(optarg)));
+      break;
+    default:
+      usage();
+      return 1;
+    }
+  }
+  if (optind != argc) {
+    usage();
+    return 1;
+  }
+
+  try {
+    const vmml::Vector<3, int64_t> & dims = params.dims;
+    // The overlap has to be the thinnest side of the intersection, and leave a ROI
+    // between the one voxel margins calcSpawnTable trims on either side
+    if (params.overlap < 3 || params.overlap > dims.x() || params.overlap >= dims.y() || params.overlap >= dims.z()) {
+      throw std::string("Overlap must be at least 3 voxels and thinner than the chunk.");
+    }
+    if (params.wide && params.idType != MetaDataType::UInt64) {
+      throw std::string("Wide IDs need 64-bit segment IDs (-i 64).");
+    }
+    if (palette && params.idType == MetaDataType::UInt64) {
+      throw std::string("Palettes hold 32-bit IDs, -p needs -i 8, 16 or 32.");
+    }
+
+    CSyntheticChunk pre, post;
+    const int64_t shift = (cellSize(params) + 2) / 4;
+    makeChunk(pre, params, 0, 0);
+    makeChunk(post, params, dims.x() - params.overlap, shift);
+    if (palette) {
+      pre.volume->ConvertToPalette();
+      post.volume->ConvertToPalette();
+    }
+
+    const uint64_t roiVoxels = uint64_t((params.overlap - 2) * dims.y() * dims.z());
+    auto describe = [&](CJSONLine & line, const char * bench) -> CJSONLine & {
+      return line.Add("bench", bench)
+                 .Add("dims", dims)
+                 .Add("id_type", typeName(params.idType))
+                 .Add("wide_ids", params.wide)
+                 .Add("segments", pre.volume->GetSegmentCount())
+                 .Add("run_length", params.runLength)
+                 .Add("overlap", params.overlap)
+                 .Add("threads", uint64_t(threadCount))
+                 .Add("palette", palette)
+                 .Add("repeats", uint64_t(repeats));
+    };
+
+    // calcSpawnTable, on a context as a worker process keeps it
+    CSpawnContext context(threadCount);
+    CFlatSpawnTableData spawntable;
+    CMeasurement m = measure(repeats, [&]() {
+      spawntable = CFlatSpawnTableData();
+      calcSpawnTable(spawntable, *pre.volume, *post.volume, context);
+    });
+    {
+      CJSONLine line;
+      describe(line, "calcSpawnTable").Add(m)
+        .Add("voxels", roiVoxels)
+        .Add("voxels_per_second", double(roiVoxels) / m.bestSeconds)
+        .Add("pre_segments", uint64_t(spawntable.preIDs.size()))
+        .Add("post_segments", uint64_t(spawntable.postIDs.size()))
+        .Add("pairs", uint64_t(spawntable.supportIDs.size()))
+        .Print();
+    }
+
+    {
+      CJSONLine line;
+      describe(line, "checkSpawnTableEncoder")
+        .Add("versions", checkSpawnTableEncoder(spawntable))
+        .Add("equal", true)
+        .Print();
+    }
+
+    // Serialization into a reused buffer, as spawnfaces and spawnbatch write their tables
+    std::vector<unsigned char> protobuf, flat;
+    m = measure(repeats, [&]() { serializeSpawnTable(spawntable, protobuf); });
+    {
+      CJSONLine line;
+      describe(line, "serializeSpawnTable").Add(m)
+        .Add("output_bytes", uint64_t(protobuf.size()))
+        .Add("bytes_per_second", double(protobuf.size()) / m.bestSeconds)
+        .Print();
+    }
+    m = measure(repeats, [&]() { spawntable.Write(flat); });
+    {
+      CJSONLine line;
+      describe(line, "writeFlatSpawnTable").Add(m)
+        .Add("packed", spawntable.CanPack())
+        .Add("output_bytes", uint64_t(flat.size()))
+        .Add("bytes_per_second", double(flat.size()) / m.bestSeconds)
+        .Print();
+    }
+
+    // Every list of the packed streams, decoded by the scalar and, where the CPU has it,
+    // the SSSE3 decoder. Both have to give the lists the scalar decoder gives.
+    if (CFlatSpawnTableView::HasWideIDs(flat.data(), flat.size()) || !CFlatSpawnTableView(flat.data(), flat.size()).packed) {
+      std::cerr << "Skipping decodeGroupVarint, the flat table is not packed.\n";
+    } else {
+      typedef const unsigned char * (*GroupVarintDecoder)(const unsigned char *, std::vector<uint32_t> &, const unsigned char *);
+      std::vector<std::pair<const char *, GroupVarintDecoder>> decoders(1, std::make_pair("scalar", &decodeGroupVarintListScalar));
+#if defined(GROUP_VARINT_SSSE3)
+      if (groupVarintHasSSSE3()) {
+        decoders.push_back(std::make_pair("ssse3", &decodeGroupVarintListSSSE3));
+      }
+#endif
+      if (decoders.size() == 1) {
+        std::cerr << "The CPU has no SSSE3, only the scalar group varint decoder runs.\n";
+      }
+
+      const CFlatSpawnTableView view(flat.data(), flat.size());
+      std::vector<const unsigned char *> lists;
+      for (size_t pre = 0; pre < view.preCount; ++pre) {
+        lists.push_back(view.counterpartStream + view.preOffsets[pre]);
+      }
+      for (size_t post = 0; post < view.postCount; ++post) {
+        lists.push_back(view.supportStream + view.postOffsets[post]);
+      }
+      for (size_t graph = 0; graph < view.graphCount; ++graph) {
+        lists.push_back(view.neighborStream + view.graphOffsets[graph]);
+      }
+
+      std::vector<std::vector<uint32_t>> expected(lists.size());
+      for (size_t l = 0; l < lists.size(); ++l) {
+        decodeGroupVarintListScalar(lists[l], expected[l]);
+      }
+
+      std::vector<uint32_t> values;
+      for (const auto & decoder : decoders) {
+        for (size_t l = 0; l < lists.size(); ++l) {
+          decoder.second(lists[l], values, nullptr);
+          if (values != expected[l]) {
+            throw std::string("The ") + decoder.first + " group varint decoder differs from the scalar one.";
+          }
+        }
+
+        uint64_t valueCount = 0;
+        m = measure(repeats, [&]() {
+          valueCount = 0;
+          for (const unsigned char * list : lists) {
+            decoder.second(list, values, nullptr);
+            valueCount += values.size();
+          }
+        });
+        CJSONLine line;
+        describe(line, "decodeGroupVarint").Add(m)
+          .Add("decoder", decoder.first)
+          .Add("lists", uint64_t(lists.size()))
+          .Add("values", valueCount)
+          .Add("values_per_second", double(valueCount) / m.bestSeconds)
+          .Print();
+      }
+    }
+
+    // Random selections of pre-side segments in the overlap, drawn up front and shared by
+    // both seed phases
+    std::vector<uint64_t> selections;
+    if (!spawntable.preIDs.empty()) {
+      std::mt19937 random(42);
+      std::uniform_int_distribution<size_t> pick(0, spawntable.preIDs.size() - 1);
+      selections.resize(std::max(queryCount, seedQueryCount) * selectionSize);
+      for (uint64_t & segment : selections) {
+        segment = spawntable.preIDs[pick(random)];
+      }
+    }
+    // Both seed paths log to std::cout (fallbacks, timings), keep that out of the results
+    CNullBuffer discard;
+
+    if (selections.empty()) {
+      std::cerr << "Skipping query_seeds, the spawn table is empty.\n";
+    } else {
+      // Loading a protobuf table converts it to a flat one
+      m = measure(repeats, [&]() { CSpawnTableIndex index(protobuf.data(), protobuf.size()); });
+      {
+        CJSONLine line;
+        describe(line, "loadSpawnTableIndex").Add(m)
+          .Add("input_bytes", uint64_t(protobuf.size()))
+          .Add("bytes_per_second", double(protobuf.size()) / m.bestSeconds)
+          .Print();
+      }
+
+      // CSpawnTableIndex::QuerySeeds on the flat table, the /get_seeds path of the server
+      CSpawnTableIndex index(flat.data(), flat.size());
+      std::vector<std::map<uint64_t, uint32_t>> seeds;
+      uint64_t seedCount = 0;
+      std::streambuf * stdoutBuffer = std::cout.rdbuf(&discard);
+      m = measure(repeats, [&]() {
+        seedCount = 0;
+        for (size_t q = 0; q < queryCount; ++q) {
+          index.QuerySeeds(seeds, &selections[q * selectionSize], selectionSize, 0.5);
+          seedCount += seeds.size();
+        }
+      });
+      std::cout.rdbuf(stdoutBuffer);
+      CJSONLine line;
+      describe(line, "query_seeds").Add(m)
+        .Add("queries", uint64_t(queryCount))
+        .Add("selection", uint64_t(selectionSize))
+        .Add("seeds", seedCount)
+        .Add("queries_per_second", double(queryCount) / m.bestSeconds)
+        .Print();
+    }
+
+    if (selections.empty() || params.idType == MetaDataType::UInt64 || palette) {
+      // get_seeds scans dense segmentations of up to 32-bit IDs
+      std::cerr << "Skipping get_seeds, it needs a non-empty spawn table and dense volumes of up to 32-bit IDs.\n";
+    } else {
+      // get_seeds of SpawnHelper.h on the voxels, the /get_seeds_old path of the server
+      std::vector<std::set<uint32_t>> selected;
+      for (size_t q = 0; q < seedQueryCount; ++q) {
+        selected.emplace_back(&selections[q * selectionSize], &selections[(q + 1) * selectionSize]);
+      }
+      std::vector<std::map<uint32_t, uint32_t>> seeds;
+      uint64_t seedCount = 0;
+      std::streambuf * stdoutBuffer = std::cout.rdbuf(&discard);
+      m = measure(repeats, [&]() {
+        seedCount = 0;
+        for (const std::set<uint32_t> & selection : selected) {
+          get_seeds(seeds, *pre.volume, selection, *post.volume, 0.5);
+          seedCount += seeds.size();
+        }
+      });
+      std::cout.rdbuf(stdoutBuffer);
+      CJSONLine line;
+      describe(line, "get_seeds").Add(m)
+        .Add("queries", uint64_t(seedQueryCount))
+        .Add("selection", uint64_t(selectionSize))
+        .Add("seeds", seedCount)
+        .Add("queries_per_second", double(seedQueryCount) / m.bestSeconds)
+        .Print();
+    }
+  } catch (const std::string &err) {
+    std::cerr << err << "\n";
+    return 1;
+  }
+
+  google::protobuf::ShutdownProtobufLibrary();
+  return 0;
+}
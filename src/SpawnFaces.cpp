@@ -0,0 +1,112 @@
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "ChunkLoader.h"
+#include "SpawnSetGenerator.h"
+
+#include <google/protobuf/stubs/common.h>
+
+/*****************************************************************/
+
+// Writes the spawn tables of one chunk towards its face neighbors, loading the center
+// chunk only once:
+//   spawnfaces [-t threads] [-p] [-f] [-s] [-o outdir] <center> <neighbor>...
+// Chunks are local directories laid out as in the bucket. The table towards neighbor
+// path/to/N is written to <outdir>/N.pb.spawn (or N.flat.spawn with -f); outdir
+// defaults to the center directory, as the python worker does in the bucket.
+// -p palette encodes the chunks once loaded, as spawnbatch -p does. -s writes protobuf
+// tables as version 3 (post-side segments stored once), which older servers reject.
+
+static void usage() {
+  std::cerr << "usage: spawnfaces [-t threads] [-p] [-f] [-s] [-o outdir] <center> <neighbor>...\n";
+}
+
+int main(int argc, char* argv[]) {
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+  unsigned int threadCount = 1;
+  bool palette = false;
+  bool flat = false;
+  bool sharedPosts = false;
+  std::string outdir;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "t:pfso:")) != -1) {
+    switch (opt) {
+    case 't':
+      threadCount = unsigned(std::max(1, atoi(optarg)));
+      break;
+    case 'p':
+      palette = true;
+      break;
+    case 'f':
+      flat = true;
+      break;
+    case 's':
+      sharedPosts = true;
+      break;
+    case 'o':
+      outdir = optarg;
+      break;
+    default:
+      usage();
+      return 1;
+    }
+  }
+  if (argc - optind < 2) {
+    usage();
+    return 1;
+  }
+
+  const std::string centerPath = argv[optind];
+  std::vector<std::string> neighborPaths(argv + optind + 1, argv + argc);
+  if (outdir.empty()) {
+    outdir = centerPath;
+  }
+  if (outdir.back() != '/') {
+    outdir += "/";
+  }
+
+  try {
+    CChunk center(centerPath, palette);
+    std::vector<std::unique_ptr<CChunk>> neighbors;
+    std::vector<const CVolume *> neighborVolumes;
+    for (const std::string &path : neighborPaths) {
+      neighbors.emplace_back(new CChunk(path, palette));
+      neighborVolumes.push_back(&neighbors.back()->GetVolume());
+    }
+
+    std::vector<CFlatSpawnTableData> spawntables;
+    calcSpawnTables(spawntables, center.GetVolume(), neighborVolumes, threadCount);
+
+    std::vector<unsigned char> buffer;
+    for (size_t i = 0; i < spawntables.size(); ++i) {
+      if (flat) {
+        spawntables[i].Write(buffer);
+      } else {
+        serializeSpawnTable(spawntables[i], buffer, sharedPosts);
+      }
+
+      const std::string filename = outdir + chunkName(neighborPaths[i]) + (flat ? ".flat.spawn" : ".pb.spawn");
+      std::ofstream f(filename, std::ofstream::binary);
+      f.write(reinterpret_cast<const char *>(buffer.data()), std::streamsize(buffer.size()));
+      if (!f) {
+        throw std::string("Could not write " + filename);
+      }
+      std::cout << "Wrote " << filename << "\n";
+    }
+  } catch (const std::string &err) {
+    std::cerr << err << "\n";
+    return 1;
+  }
+
+  google::protobuf::ShutdownProtobufLibrary();
+  return 0;
+}
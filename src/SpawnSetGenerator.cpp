@@ -1,10 +1,20 @@
+#include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <exception>
+#include <iostream>
 #include <map>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include "FlatSpawnTable.h"
+#include "PairCountTable.h"
+#include "PaletteSegmentation.h"
 #include "SpawnHelper.h"
+#include "SpawnSetGenerator.h"
+#include "ThreadPool.h"
 #include "Volume.h"
 
 #include "../res/spawnset.pb.h"
@@ -37,7 +47,307 @@ public:
   }
 };
 
-void calcSpawnTable(spawner::SpawnTable &spawntable, const CVolume &pre, const CVolume &post) {
+class CSpawnTableBatch {
+public:
+  uint32_t tableCount;
+  CSpawnTableWrapper * tables;
+
+  explicit CSpawnTableBatch(uint32_t tableCount_) : tableCount(tableCount_), tables(new CSpawnTableWrapper[tableCount_]) { };
+  ~CSpawnTableBatch() {
+    delete[] tables;
+    tables = nullptr;
+    tableCount = 0;
+  }
+};
+
+// Voxel scan of calcSpawnTable, templated on the segment ID types of pre and post.
+// Only the z-slices [zBegin, zEnd) of the ROI are scanned, so the ROI can be split
+// into slabs that are scanned in parallel and merged afterwards.
+// ID is the width of the count table keys: uint32_t unless a side has 64-bit segment
+// IDs, so narrower segmentations keep single-word keys. run is instantiated for every
+// pair of segmentation types, but only called with types no wider than ID.
+template <typename ID>
+struct CSpawnTableScan {
+  vmml::AABB<int64_t>    preVolumeROI;
+  vmml::AABB<int64_t>    postVolumeROI;
+  int64_t                zBegin;
+  int64_t                zEnd;
+
+  CPairCountTableT<ID>   mappingCounts;   // (pre, post) -> overlapping voxels
+  CPairCountTableT<ID>   neighborsPost;   // undirected post-side edges, stored once per edge
+
+  template <typename TPre, typename TPost>
+  static void run(const CSegmentationView<TPre> &preSegmentation, const CSegmentationView<TPost> &postSegmentation, CSpawnTableScan &scan);
+
+  // Same scan on palette encoded volumes, see below
+  static void runPalette(const CPaletteSegmentation &preSegmentation, const CPaletteSegmentation &postSegmentation, CSpawnTableScan &scan);
+
+  void Merge(const CSpawnTableScan &other);
+  void Clear();   // for reuse, keeps the capacity of the tables
+};
+
+template <typename ID>
+template <typename TPre, typename TPost>
+void CSpawnTableScan<ID>::run(const CSegmentationView<TPre> &preSegmentation, const CSegmentationView<TPost> &postSegmentation, CSpawnTableScan &scan) {
+  const vmml::AABB<int64_t> &preVolumeROI = scan.preVolumeROI;
+  const vmml::AABB<int64_t> &postVolumeROI = scan.postVolumeROI;
+  vmml::Vector<3, int64_t> dimROI = preVolumeROI.getDimension();
+
+  CPairCountTableT<ID> &mappingCounts = scan.mappingCounts;
+  CPairCountTableT<ID> &neighborsPost = scan.neighborsPost;
+
+  const int64_t postStrideY = postSegmentation.StrideY();
+  const int64_t postStrideZ = postSegmentation.StrideZ();
+
+  // Neighbors at z - 1 may belong to the previous slab. They are only read, and
+  // each edge is recorded by the slab owning its upper voxel, so no edge is lost at seams.
+  for (int64_t z = scan.zBegin; z < scan.zEnd; ++z) {
+    for (int64_t y = 0; y < dimROI.y(); ++y) {
+      const TPre * preRow = preSegmentation.Ptr(preVolumeROI.getMin().x(), preVolumeROI.getMin().y() + y, preVolumeROI.getMin().z() + z);
+      const TPost * postRow = postSegmentation.Ptr(postVolumeROI.getMin().x(), postVolumeROI.getMin().y() + y, postVolumeROI.getMin().z() + z);
+      // Overlap counts and x-neighbors, both only change at run boundaries
+      for (CRowRuns<TPre, TPost> run(preRow, postRow, dimROI.x()); run.Next(); ) {
+        ID segID = run.first;
+        ID postSegID = run.second;
+        if (postSegID > 0) {
+          if (segID > 0) {
+            mappingCounts.Add(segID, postSegID, uint32_t(run.runLength));
+          }
+
+          if (run.begin > 0) {
+            ID neighborSegID = postRow[run.begin - 1];
+            if (neighborSegID > 0 && neighborSegID != postSegID) {
+              neighborsPost.Add(CPairCountTableT<ID>::PackUnordered(postSegID, neighborSegID));
+            }
+          }
+        }
+      }
+
+      // y- and z-neighbors, compared run-wise against the previous row and slice
+      if (y > 0) {
+        for (CRowRuns<TPost, TPost> run(postRow, postRow - postStrideY, dimROI.x()); run.Next(); ) {
+          if (run.first > 0 && run.second > 0 && run.first != run.second) {
+            neighborsPost.Add(CPairCountTableT<ID>::PackUnordered(run.first, run.second));
+          }
+        }
+      }
+      if (z > 0) {
+        for (CRowRuns<TPost, TPost> run(postRow, postRow - postStrideZ, dimROI.x()); run.Next(); ) {
+          if (run.first > 0 && run.second > 0 && run.first != run.second) {
+            neighborsPost.Add(CPairCountTableT<ID>::PackUnordered(run.first, run.second));
+          }
+        }
+      }
+    }
+  }
+}
+
+// Cell boundaries along one axis of the ROI, in ROI coordinates: begin, end and every
+// block boundary of either side in between. preOrigin and postOrigin are the offsets of
+// the ROI minimum from the block grid origin of each side.
+static std::vector<int64_t> cellCuts(int64_t preOrigin, int64_t postOrigin, int64_t begin, int64_t end) {
+  const int64_t B = CPaletteSegmentation::BLOCK_SIZE;
+  std::vector<int64_t> cuts(1, begin);
+  for (int64_t r = begin; r < end; ) {
+    r = std::min(end, std::min(r + B - (preOrigin + r) % B, r + B - (postOrigin + r) % B));
+    cuts.push_back(r);
+  }
+  return cuts;
+}
+
+// Decodes the box [min, min + n) of segmentation into cell, x-fastest
+static void decodeCell(const CPaletteSegmentation &segmentation, const vmml::Vector<3, int64_t> &min, const vmml::Vector<3, int64_t> &n, std::vector<uint32_t> &cell) {
+  cell.resize(size_t(n.x() * n.y() * n.z()));
+  uint32_t * row = cell.data();
+  for (int64_t z = 0; z < n.z(); ++z) {
+    for (int64_t y = 0; y < n.y(); ++y, row += n.x()) {
+      segmentation.DecodeRow(min.x(), min.y() + y, min.z() + z, n.x(), row);
+    }
+  }
+}
+
+// The ROI is cut into cells, the intersections of pre and post blocks. A cell that is a
+// single segment on both sides adds its voxel count in O(1), a face between two single
+// segment post cells is one comparison; only the remaining cells and faces are decoded.
+// As in run, each edge is recorded by the cell owning its upper voxel.
+template <typename ID>
+void CSpawnTableScan<ID>::runPalette(const CPaletteSegmentation &preSegmentation, const CPaletteSegmentation &postSegmentation, CSpawnTableScan &scan) {
+  const vmml::Vector<3, int64_t> preMin = scan.preVolumeROI.getMin();
+  const vmml::Vector<3, int64_t> postMin = scan.postVolumeROI.getMin();
+  const vmml::Vector<3, int64_t> dimROI = scan.preVolumeROI.getDimension();
+
+  CPairCountTableT<ID> &mappingCounts = scan.mappingCounts;
+  CPairCountTableT<ID> &neighborsPost = scan.neighborsPost;
+  auto addEdge = [&neighborsPost](uint32_t a, uint32_t b) {
+    if (a > 0 && b > 0 && a != b) {
+      neighborsPost.Add(CPairCountTableT<ID>::PackUnordered(a, b));
+    }
+  };
+
+  std::vector<int64_t> cuts[3];
+  for (int axis = 0; axis < 3; ++axis) {
+    cuts[axis] = cellCuts(preMin[axis] - preSegmentation.GetBounds().getMin()[axis], postMin[axis] - postSegmentation.GetBounds().getMin()[axis],
+                          axis == 2 ? scan.zBegin : 0, axis == 2 ? scan.zEnd : dimROI[axis]);
+  }
+
+  std::vector<uint32_t> preCell, postCell, face;
+  for (size_t k = 0; k + 1 < cuts[2].size(); ++k) {
+    for (size_t j = 0; j + 1 < cuts[1].size(); ++j) {
+      for (size_t i = 0; i + 1 < cuts[0].size(); ++i) {
+        const vmml::Vector<3, int64_t> lo(cuts[0][i], cuts[1][j], cuts[2][k]);
+        const vmml::Vector<3, int64_t> n(cuts[0][i + 1] - lo.x(), cuts[1][j + 1] - lo.y(), cuts[2][k + 1] - lo.z());
+        const vmml::Vector<3, int64_t> pre = preMin + lo;
+        const vmml::Vector<3, int64_t> post = postMin + lo;
+
+        uint32_t preID, postID;
+        const vmml::Vector<3, int64_t> preBlock = preSegmentation.BlockOf(pre.x(), pre.y(), pre.z());
+        const vmml::Vector<3, int64_t> postBlock = postSegmentation.BlockOf(post.x(), post.y(), post.z());
+        const bool preUniform = preSegmentation.IsUniform(preBlock.x(), preBlock.y(), preBlock.z(), preID);
+        const bool postUniform = postSegmentation.IsUniform(postBlock.x(), postBlock.y(), postBlock.z(), postID);
+
+        // Overlap counts
+        bool decoded = false;
+        if (preUniform && postUniform) {
+          if (preID > 0 && postID > 0) {
+            mappingCounts.Add(preID, postID, uint32_t(n.x() * n.y() * n.z()));
+          }
+        } else {
+          decodeCell(preSegmentation, pre, n, preCell);
+          decodeCell(postSegmentation, post, n, postCell);
+          decoded = true;
+          for (size_t row = 0; row < postCell.size(); row += size_t(n.x())) {
+            for (CRowRuns<uint32_t, uint32_t> run(&preCell[row], &postCell[row], n.x()); run.Next(); ) {
+              if (run.first > 0 && run.second > 0) {
+                mappingCounts.Add(run.first, run.second, uint32_t(run.runLength));
+              }
+            }
+          }
+        }
+
+        // Post-side edges inside the cell
+        if (!postUniform) {
+          const int64_t strideZ = n.x() * n.y();
+          for (int64_t z = 0; z < n.z(); ++z) {
+            for (int64_t y = 0; y < n.y(); ++y) {
+              const uint32_t * row = &postCell[size_t(y * n.x() + z * strideZ)];
+              for (int64_t x = 1; x < n.x(); ++x) {
+                addEdge(row[x], row[x - 1]);
+              }
+              if (y > 0) {
+                for (CRowRuns<uint32_t, uint32_t> run(row, row - n.x(), n.x()); run.Next(); ) {
+                  addEdge(run.first, run.second);
+                }
+              }
+              if (z > 0) {
+                for (CRowRuns<uint32_t, uint32_t> run(row, row - strideZ, n.x()); run.Next(); ) {
+                  addEdge(run.first, run.second);
+                }
+              }
+            }
+          }
+        }
+
+        // Post-side edges across the lower faces, which lie within a single neighbor block
+        for (int axis = 0; axis < 3; ++axis) {
+          if (lo[axis] == 0) {
+            continue;
+          }
+          vmml::Vector<3, int64_t> below = post;
+          below[axis] -= 1;
+          const vmml::Vector<3, int64_t> belowBlock = postSegmentation.BlockOf(below.x(), below.y(), below.z());
+          uint32_t belowID;
+          if (postSegmentation.IsUniform(belowBlock.x(), belowBlock.y(), belowBlock.z(), belowID) && postUniform) {
+            addEdge(postID, belowID);
+            continue;
+          }
+          if (!decoded) {
+            decodeCell(postSegmentation, post, n, postCell);
+            decoded = true;
+          }
+          if (axis == 0) {
+            for (int64_t z = 0; z < n.z(); ++z) {
+              for (int64_t y = 0; y < n.y(); ++y) {
+                addEdge(postCell[size_t(y * n.x() + z * n.x() * n.y())], postSegmentation(below.x(), below.y() + y, below.z() + z));
+              }
+            }
+          } else {
+            // One row of the face per z (y-face) or per y (z-face)
+            face.resize(size_t(n.x()));
+            const int64_t rows = axis == 1 ? n.z() : n.y();
+            for (int64_t r = 0; r < rows; ++r) {
+              const int64_t y = axis == 1 ? 0 : r;
+              const int64_t z = axis == 1 ? r : 0;
+              postSegmentation.DecodeRow(below.x(), below.y() + y, below.z() + z, n.x(), face.data());
+              for (CRowRuns<uint32_t, uint32_t> run(&postCell[size_t(y * n.x() + z * n.x() * n.y())], face.data(), n.x()); run.Next(); ) {
+                addEdge(run.first, run.second);
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+// Palette encodes the box bounds of a dense volume, for scans where only the other side is palette encoded
+struct CPaletteEncode {
+  template <typename T>
+  static void run(const CSegmentationView<T> &segmentation, const vmml::AABB<int64_t> &bounds, std::unique_ptr<CPaletteSegmentation> &palette) {
+    palette.reset(new CPaletteSegmentation(segmentation, bounds));
+  }
+};
+
+template <typename ID>
+void CSpawnTableScan<ID>::Merge(const CSpawnTableScan &other) {
+  mappingCounts.Merge(other.mappingCounts);
+  neighborsPost.Merge(other.neighborsPost);
+}
+
+template <typename ID>
+void CSpawnTableScan<ID>::Clear() {
+  mappingCounts.Clear();
+  neighborsPost.Clear();
+}
+
+/*****************************************************************/
+
+// Rethrows the first error captured on a worker thread, once all workers have finished
+static void rethrowFirst(const std::vector<std::exception_ptr> &errors) {
+  for (const std::exception_ptr &error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+// Slab scans kept by a CSpawnContext between calls, so their count tables are allocated once
+struct CSpawnContext::CScratch {
+  std::vector<CSpawnTableScan<uint32_t>> slabs32;
+  std::vector<CSpawnTableScan<uint64_t>> slabs64;
+
+  std::vector<CSpawnTableScan<uint32_t>> & Slabs(uint32_t) { return slabs32; }
+  std::vector<CSpawnTableScan<uint64_t>> & Slabs(uint64_t) { return slabs64; }
+};
+
+CSpawnContext::CSpawnContext(unsigned int threadCount) :
+  pool_(new CThreadPool(std::max(1u, threadCount))),
+  scratch_(new CScratch())
+{
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+}
+
+CSpawnContext::~CSpawnContext() {
+}
+
+unsigned int CSpawnContext::GetThreadCount() const {
+  return unsigned(pool_->GetThreadCount());
+}
+
+// Entries are emitted in ascending ID order, so the table does not depend on threadCount.
+// The slabs run on pool if given, on threads of their own otherwise; slabs holds the scans
+// and may keep them from a previous call.
+template <typename ID>
+static void calcSpawnTableT(CFlatSpawnTableData &spawntable, const CVolume &pre, const CVolume &post, unsigned int threadCount, CThreadPool * pool, std::vector<CSpawnTableScan<ID>> &slabs) {
 #pragma region SanityChecks
   vmml::Vector<3, int64_t> res = pre.GetVoxelResolution();
   vmml::AABB<int64_t> prePhysicalBounds = pre.GetPhysicalBounds();
@@ -57,73 +367,127 @@ void calcSpawnTable(spawner::SpawnTable &spawntable, const CVolume &pre, const C
   }
 
   vmml::AABB<int64_t> roiWorld = getOverlapRegion(preBoundsWorld, postBoundsWorld, dir, 1, 1);
-  vmml::AABB<int64_t> preVolumeROI = vmml::subtractVector(roiWorld, preBoundsWorld.getMin());
-  vmml::AABB<int64_t> postVolumeROI = vmml::subtractVector(roiWorld, postBoundsWorld.getMin());
 
-  vmml::Vector<3, int64_t> dimROI = roiWorld.getDimension();
-  int64_t volumeROI = dimROI.x() * dimROI.y() * dimROI.z();
+  int64_t depthROI = roiWorld.getDimension().z();
+  int64_t slabCount = std::max<int64_t>(1, std::min<int64_t>(threadCount, depthROI));
 
-  std::unordered_map<uint32_t, std::unordered_map<uint32_t, int>> mappingCountsPrePost;
-  std::unordered_map<uint32_t, std::unordered_map<uint32_t, int>> mappingCountsPostPre;
-  std::unordered_map<uint32_t, int> overlapSizePost;
-  std::unordered_map<uint32_t, std::unordered_set<uint32_t>> neighborsPost;
+  slabs.resize(size_t(slabCount));
+  for (int64_t i = 0; i < slabCount; ++i) {
+    slabs[i].Clear();
+    slabs[i].preVolumeROI = vmml::subtractVector(roiWorld, preBoundsWorld.getMin());
+    slabs[i].postVolumeROI = vmml::subtractVector(roiWorld, postBoundsWorld.getMin());
+    slabs[i].zBegin = depthROI * i / slabCount;
+    slabs[i].zEnd = depthROI * (i + 1) / slabCount;
+  }
+  CSpawnTableScan<ID> &scan = slabs[0];
+
+  // Palette encoded volumes are scanned block-wise; a dense side facing one is encoded
+  // over the ROI only
+  const CPaletteSegmentation * prePalette = pre.GetPaletteSegmentation();
+  const CPaletteSegmentation * postPalette = post.GetPaletteSegmentation();
+  std::unique_ptr<CPaletteSegmentation> encoded;
+  if ((prePalette || postPalette) && (pre.GetSegmentIdType() == MetaDataType::UInt64 || post.GetSegmentIdType() == MetaDataType::UInt64)) {
+    throw(std::string("Palette encoded volumes cannot be scanned against 64-bit segmentations."));
+  }
+  if (prePalette && !postPalette) {
+    post.Dispatch<CPaletteEncode>(scan.postVolumeROI, encoded);
+    postPalette = encoded.get();
+  } else if (postPalette && !prePalette) {
+    pre.Dispatch<CPaletteEncode>(scan.preVolumeROI, encoded);
+    prePalette = encoded.get();
+  }
+  auto scanSlab = [&pre, &post, prePalette, postPalette](CSpawnTableScan<ID> &slab) {
+    if (prePalette) {
+      CSpawnTableScan<ID>::runPalette(*prePalette, *postPalette, slab);
+    } else {
+      dispatchSegmentations<CSpawnTableScan<ID>>(pre, post, slab);
+    }
+  };
 #pragma endregion Initialization and sanity checks
 
 #pragma region PostSideMatches
-
-  
-  vmml::Vector<3, int64_t> preROIPos(preVolumeROI.getMin());
-  vmml::Vector<3, int64_t> postROIPos(postVolumeROI.getMin());
-  const CSegmentation & preSegmentation = *(pre.GetSegmentation());
-  const CSegmentation & postSegmentation = *(post.GetSegmentation());
-  for (int64_t z = 0; z < dimROI.z(); ++z, ++preROIPos.z(), ++postROIPos.z()) {
-    preROIPos.y() = preVolumeROI.getMin().y();
-    postROIPos.y() = postVolumeROI.getMin().y();
-    for (int64_t y = 0; y < dimROI.y(); ++y, ++preROIPos.y(), ++postROIPos.y()) {
-      preROIPos.x() = preVolumeROI.getMin().x();
-      postROIPos.x() = postVolumeROI.getMin().x();
-      for (int64_t x = 0; x < dimROI.x(); ++x, ++preROIPos.x(), ++postROIPos.x()) {
-        uint32_t segID = preSegmentation(preROIPos);
-        uint32_t postSegID = postSegmentation(postROIPos);
-        if (postSegID > 0) {
-          if (segID > 0) {
-            mappingCountsPrePost[segID][postSegID]++;
-            mappingCountsPostPre[postSegID][segID]++;
-            overlapSizePost[postSegID]++;
-          }
-
-          if (x > 0) {
-            uint32_t neighborSegID = postSegmentation(postROIPos.x() - 1, postROIPos.y(), postROIPos.z());
-            if (neighborSegID > 0 && neighborSegID != postSegID) {
-              neighborsPost[postSegID].emplace(neighborSegID);
-              neighborsPost[neighborSegID].emplace(postSegID);
-            }
-          }
-          if (y > 0) {
-            uint32_t neighborSegID = postSegmentation(postROIPos.x(), postROIPos.y() - 1, postROIPos.z());
-            if (neighborSegID > 0 && neighborSegID != postSegID) {
-              neighborsPost[postSegID].emplace(neighborSegID);
-              neighborsPost[neighborSegID].emplace(postSegID);
-            }
-          }
-          if (z > 0) {
-            uint32_t neighborSegID = postSegmentation(postROIPos.x(), postROIPos.y(), postROIPos.z() - 1);
-            if (neighborSegID > 0 && neighborSegID != postSegID) {
-              neighborsPost[postSegID].emplace(neighborSegID);
-              neighborsPost[neighborSegID].emplace(postSegID);
-            }
-          }
-        }
+  if (slabCount == 1) {
+    scanSlab(scan);
+  } else {
+    // Nothing may escape a pool task or thread, errors of the slabs are rethrown here
+    std::vector<std::exception_ptr> errors(slabCount);
+    auto scanGuarded = [&scanSlab, &slabs, &errors](int64_t i) {
+      try {
+        scanSlab(slabs[i]);
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    };
+    if (pool) {
+      for (int64_t i = 0; i < slabCount; ++i) {
+        pool->Submit([&scanGuarded, i]() { scanGuarded(i); });
       }
+      pool->Wait();
+    } else {
+      std::vector<std::thread> workers;
+      for (int64_t i = 0; i < slabCount; ++i) {
+        workers.emplace_back(scanGuarded, i);
+      }
+      for (auto &worker : workers) {
+        worker.join();
+      }
+    }
+    rethrowFirst(errors);
+    for (int64_t i = 1; i < slabCount; ++i) {
+      scan.Merge(slabs[i]);
     }
   }
 #pragma endregion Find post-side matches
 
-  auto& spawnEntries = *spawntable.mutable_prespawnmap();
-  for (auto preKey : mappingCountsPrePost) {
+#pragma region CountViews
+  // Pre -> post view, sorted by (pre, post)
+  std::vector<CPairCountT<ID>> mappingCountsPrePost = scan.mappingCounts.Sorted();
+
+  // Post -> pre view, sorted by (post, pre)
+  std::vector<CPairCountT<ID>> mappingCountsPostPre;
+  mappingCountsPostPre.reserve(mappingCountsPrePost.size());
+  for (const CPairCountT<ID> &pair : mappingCountsPrePost) {
+    CPairCountT<ID> swapped = { pair.second, pair.first, pair.count };
+    mappingCountsPostPre.push_back(swapped);
+  }
+  std::sort(mappingCountsPostPre.begin(), mappingCountsPostPre.end());
+
+  // Per post-side segment: range of its pre-side supports, overlap size and whether it is allowed to spawn
+  std::vector<ID> postSegmentIDs;
+  std::vector<size_t> postSupportOffsets;
+  std::vector<uint32_t> overlapSizePost;
+  std::vector<bool> postCanSpawn;
+  for (size_t i = 0; i < mappingCountsPostPre.size(); ++i) {
+    ID postSegmentID = mappingCountsPostPre[i].first;
+    if (postSegmentIDs.empty() || postSegmentIDs.back() != postSegmentID) {
+      auto segBoundsWorld = vmml::divideVector(post.GetSegmentBoundsWorld(postSegmentID), res);
+      postSegmentIDs.push_back(postSegmentID);
+      postSupportOffsets.push_back(i);
+      overlapSizePost.push_back(0);
+      postCanSpawn.push_back((intersect(segBoundsWorld, postHalfOverlapWorld).isEmpty() == false) && (is_valid_segment(postSegmentID, post)));
+    }
+    overlapSizePost.back() += mappingCountsPostPre[i].count;
+  }
+  postSupportOffsets.push_back(mappingCountsPostPre.size());
+#pragma endregion Derive pre->post and post->pre views from the pair counts
+
+  spawntable.postIDs.assign(postSegmentIDs.begin(), postSegmentIDs.end());
+  spawntable.postOverlapSizes = overlapSizePost;
+  spawntable.postOffsets.assign(postSupportOffsets.begin(), postSupportOffsets.end());
+  spawntable.supportIDs.reserve(mappingCountsPostPre.size());
+  spawntable.supportSizes.reserve(mappingCountsPostPre.size());
+  for (const CPairCountT<ID> &pair : mappingCountsPostPre) {
+    spawntable.supportIDs.push_back(pair.second);
+    spawntable.supportSizes.push_back(pair.count);
+  }
+
+  for (size_t preBegin = 0, preEnd = 0; preBegin < mappingCountsPrePost.size(); preBegin = preEnd) {
+    ID preSegmentID = mappingCountsPrePost[preBegin].first;
+    for (preEnd = preBegin + 1; preEnd < mappingCountsPrePost.size() && mappingCountsPrePost[preEnd].first == preSegmentID; ++preEnd);
+
     // Check if pre-side segment is allowed to spawn
-    auto segBoundsWorld = vmml::divideVector(pre.GetSegmentBoundsWorld(preKey.first), res);
-    bool preCanSpawn = (intersect(segBoundsWorld, postHalfOverlapWorld).isEmpty() == false) && (is_valid_segment(preKey.first, pre));
+    auto segBoundsWorld = vmml::divideVector(pre.GetSegmentBoundsWorld(preSegmentID), res);
+    bool preCanSpawn = (intersect(segBoundsWorld, postHalfOverlapWorld).isEmpty() == false) && (is_valid_segment(preSegmentID, pre));
 
     // Set post-side counterparts
     // Possible cases:
@@ -132,92 +496,364 @@ void calcSpawnTable(spawner::SpawnTable &spawntable, const CVolume &pre, const C
     //   C) M:1 match, the pre-side segment has exactly 1 post-side segment, but this segment is also partially covered by other pre-side segments
     //   D) N:M match, the pre-side segment has multiple post-side segment matches that are full or only partially enclosed (some refer to other pre-side segments)
 
-    // preKey: pre-side segment, current key.
-    // postSeg: post-side segment(s), all overlap with `preSeg` (partially or fully)
-    // preSeg: pre-side segment(s), all overlap with `postSeg` (partially or fully), includes the original `preKey`
+    // preSegmentID: pre-side segment, current key.
+    // postSegmentID: post-side segment(s), all overlap with `preSegmentID` (partially or fully)
+    // preSupport: pre-side segment(s), all overlap with `postSegmentID` (partially or fully), includes the original `preSegmentID`
 
-    spawner::SpawnMapEntry spawnEntry;
-    auto & postSegments = preKey.second;
-    for (auto postSeg : postSegments) {
-      uint32_t postSegmentID = postSeg.first;
-      auto segBoundsWorld = vmml::divideVector(post.GetSegmentBoundsWorld(postSegmentID), res);
-      bool postCanSpawn = (intersect(segBoundsWorld, postHalfOverlapWorld).isEmpty() == false) && (is_valid_segment(postSegmentID, post));
-
-      spawner::PostSegment* postMatch = spawnEntry.add_postsidecounterparts();
-      postMatch->set_id(postSegmentID);
-      postMatch->set_overlapsize(overlapSizePost[postSegmentID]);
-      postMatch->set_canspawn(preCanSpawn && postCanSpawn);
-
-      for (auto preSeg : mappingCountsPostPre[postSegmentID]) {
-        uint32_t preSegmentID = preSeg.first;
-        spawner::PreSegment* preSupport = postMatch->add_presidesupports();
-        preSupport->set_id(preSegmentID);
-        preSupport->set_intersectionsize(mappingCountsPrePost[preSegmentID][postSegmentID]);
-      }
+    spawntable.preIDs.push_back(preSegmentID);
+    for (size_t i = preBegin; i < preEnd; ++i) {
+      ID postSegmentID = mappingCountsPrePost[i].second;
+      size_t postIndex = std::lower_bound(postSegmentIDs.begin(), postSegmentIDs.end(), postSegmentID) - postSegmentIDs.begin();
+
+      spawntable.counterpartPosts.push_back(uint32_t(postIndex));
+      spawntable.counterpartCanSpawn.push_back(preCanSpawn && postCanSpawn[postIndex] ? 1 : 0);
     }
+    spawntable.preOffsets.push_back(uint32_t(spawntable.counterpartPosts.size()));
+  }
 
-    spawnEntries[preKey.first] = std::move(spawnEntry);
+  // Both directions of each post-side edge, sorted by (segment, neighbor)
+  std::vector<CPairCountT<ID>> edges = scan.neighborsPost.Sorted();
+  std::vector<CPairCountT<ID>> neighborsPost;
+  neighborsPost.reserve(2 * edges.size());
+  for (const CPairCountT<ID> &edge : edges) {
+    CPairCountT<ID> swapped = { edge.second, edge.first, edge.count };
+    neighborsPost.push_back(edge);
+    neighborsPost.push_back(swapped);
   }
+  std::sort(neighborsPost.begin(), neighborsPost.end());
 
-  auto& rgEntries = *spawntable.mutable_postregiongraph();
-  for (auto postKey : neighborsPost) {
-    spawner::RegionGraphEntry rgEntry;
+  spawntable.graphNeighbors.reserve(neighborsPost.size());
+  for (size_t begin = 0, end = 0; begin < neighborsPost.size(); begin = end) {
+    ID postSegmentID = neighborsPost[begin].first;
+    spawntable.graphIDs.push_back(postSegmentID);
     // Post-side neighbors
-    for (auto neighbor : postKey.second) {
-      spawner::PostSegment* postNeighbor = rgEntry.add_postsideneighbors();
-      postNeighbor->set_id(neighbor);
+    for (end = begin; end < neighborsPost.size() && neighborsPost[end].first == postSegmentID; ++end) {
+      spawntable.graphNeighbors.push_back(neighborsPost[end].second);
     }
+    spawntable.graphOffsets.push_back(uint32_t(spawntable.graphNeighbors.size()));
+  }
 
-    rgEntries[postKey.first] = std::move(rgEntry);
+}
+
+void calcSpawnTable(CFlatSpawnTableData &spawntable, const CVolume &pre, const CVolume &post, unsigned int threadCount) {
+  if (pre.GetSegmentIdType() == MetaDataType::UInt64 || post.GetSegmentIdType() == MetaDataType::UInt64) {
+    std::vector<CSpawnTableScan<uint64_t>> slabs;
+    calcSpawnTableT<uint64_t>(spawntable, pre, post, threadCount, nullptr, slabs);
+  } else {
+    std::vector<CSpawnTableScan<uint32_t>> slabs;
+    calcSpawnTableT<uint32_t>(spawntable, pre, post, threadCount, nullptr, slabs);
   }
+}
 
+void calcSpawnTable(CFlatSpawnTableData &spawntable, const CVolume &pre, const CVolume &post, CSpawnContext &context) {
+  CThreadPool * pool = context.pool_.get();
+  if (pre.GetSegmentIdType() == MetaDataType::UInt64 || post.GetSegmentIdType() == MetaDataType::UInt64) {
+    calcSpawnTableT<uint64_t>(spawntable, pre, post, context.GetThreadCount(), pool, context.scratch_->Slabs(uint64_t()));
+  } else {
+    calcSpawnTableT<uint32_t>(spawntable, pre, post, context.GetThreadCount(), pool, context.scratch_->Slabs(uint32_t()));
+  }
 }
 
-extern "C" CSpawnTableWrapper * SpawnSet_Generate(CInputVolume * pre, CInputVolume * post) {
-  GOOGLE_PROTOBUF_VERIFY_VERSION;
+void calcSpawnTables(std::vector<CFlatSpawnTableData> &spawntables, const CVolume &center, const std::vector<const CVolume *> &neighbors, unsigned int threadCount) {
+  spawntables.assign(neighbors.size(), CFlatSpawnTableData());
+  if (neighbors.empty()) {
+    return;
+  }
 
-  size_t metadataLength = strlen(pre->metadata);
-  std::vector<unsigned char> pre_meta_vec(pre->metadata, pre->metadata + metadataLength);
-  
-  metadataLength = strlen(post->metadata);
-  std::vector<unsigned char> post_meta_vec(post->metadata, post->metadata + metadataLength);
+  const unsigned int workerCount = std::max(1u, std::min<unsigned int>(threadCount, unsigned(neighbors.size())));
+  const unsigned int threadsPerFace = std::max(1u, threadCount / unsigned(neighbors.size()));
 
-  std::vector<unsigned char> pre_segbbox_vec(pre->bboxes, pre->bboxes + pre->bboxesLength);
-  std::vector<unsigned char> post_segbbox_vec(post->bboxes, post->bboxes + post->bboxesLength);
-  
-  std::vector<unsigned char> pre_segsize_vec(pre->sizes, pre->sizes + pre->sizesLength);
-  std::vector<unsigned char> post_segsize_vec(post->sizes, post->sizes + post->sizesLength);
+  std::atomic<size_t> nextFace(0);
+  std::vector<std::exception_ptr> errors(workerCount);
+  auto work = [&](unsigned int worker) {
+    try {
+      for (size_t face = nextFace++; face < neighbors.size(); face = nextFace++) {
+        calcSpawnTable(spawntables[face], center, *neighbors[face], threadsPerFace);
+      }
+    } catch (...) {
+      errors[worker] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (unsigned int i = 1; i < workerCount; ++i) {
+    workers.emplace_back(work, i);
+  }
+  work(0);
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  rethrowFirst(errors);
+}
 
+void serializeSpawnTable(const CFlatSpawnTableData &flatSpawntable, std::vector<unsigned char> &buffer, bool sharedPosts) {
+  flatSpawntable.WriteSpawnTable(buffer, sharedPosts);
+}
 
-  // Volume
-  std::unique_ptr<CVolumeMetadata> pre_meta(new CVolumeMetadata(pre_meta_vec, pre_segbbox_vec, pre_segsize_vec));
-  std::unique_ptr<CVolumeMetadata> post_meta(new CVolumeMetadata(post_meta_vec, post_segbbox_vec, post_segsize_vec));
+/*****************************************************************/
 
-  // Segmentation Images
-  std::vector<unsigned char> pre_segmentation_vec(pre->segmentation, pre->segmentation + pre->segmentationLength);
-  std::vector<unsigned char> post_segmentation_vec(post->segmentation, post->segmentation + post->segmentationLength);
+static std::unique_ptr<CVolumeMetadata> makeMetadata(const CInputVolume * input) {
+  return std::unique_ptr<CVolumeMetadata>(new CVolumeMetadata(
+    CBufferView(reinterpret_cast<const unsigned char *>(input->metadata), strlen(input->metadata)),
+    CBufferView(input->bboxes, input->bboxesLength),
+    CBufferView(input->sizes, input->sizesLength)));
+}
 
-  CVolume pre_volume(std::move(pre_meta), pre_segmentation_vec);
-  CVolume post_volume(std::move(post_meta), post_segmentation_vec);
+// Volume borrowing all buffers from the caller
+static std::unique_ptr<CVolume> makeVolume(const CInputVolume * input) {
+  return std::unique_ptr<CVolume>(new CVolume(makeMetadata(input), CBufferView(input->segmentation, input->segmentationLength)));
+}
 
-  spawner::SpawnTable spawntable;
-  spawntable.set_version(1);
-  calcSpawnTable(spawntable, pre_volume, post_volume);
+// Volume decoding only the bounds of the segmentation.lzma or segmentation.blocks the
+// caller passes as segmentation, into its own storage
+static std::unique_ptr<CVolume> makeCompressedVolume(const CInputVolume * input, std::unique_ptr<CVolumeMetadata> &&meta, const vmml::AABB<int64_t> &bounds) {
+  return std::unique_ptr<CVolume>(new CVolume(std::move(meta), CBufferView(input->segmentation, input->segmentationLength), bounds));
+}
 
-  CSpawnTableWrapper * spawntableWrapper = new CSpawnTableWrapper();
-  size_t size = spawntable.ByteSizeLong();
-  unsigned char * spawntableBuffer = new unsigned char[size];
-  spawntable.SerializeToArray((void*)spawntableBuffer, size);
+static unsigned int resolveThreadCount(uint32_t threadCount) {
+  return threadCount == 0 ? std::max(1u, std::thread::hardware_concurrency()) : threadCount;
+}
+
+static void fillWrapper(CSpawnTableWrapper &spawntableWrapper, const std::vector<unsigned char> &buffer) {
+  spawntableWrapper.spawntableLength = uint32_t(buffer.size());
+  spawntableWrapper.spawntableBuffer = new unsigned char[buffer.size()];
+  memcpy(spawntableWrapper.spawntableBuffer, buffer.data(), buffer.size());
+}
+
+static void writeSpawnTable(const CFlatSpawnTableData &flatSpawntable, bool flat, bool sharedPosts, std::vector<unsigned char> &buffer) {
+  if (flat) {
+    flatSpawntable.Write(buffer);
+  } else {
+    serializeSpawnTable(flatSpawntable, buffer, sharedPosts);
+  }
+}
 
-  spawntableWrapper->spawntableLength = uint32_t(size);
-  spawntableWrapper->spawntableBuffer = spawntableBuffer;
+// Volumes of a pre/post pair. Compressed segmentations (segmentation.lzma or
+// segmentation.blocks) are only decoded over the overlap region.
+static void makePairVolumes(const CInputVolume * pre, const CInputVolume * post, bool compressed, std::unique_ptr<CVolume> &pre_volume, std::unique_ptr<CVolume> &post_volume) {
+  if (!compressed) {
+    pre_volume = makeVolume(pre);
+    post_volume = makeVolume(post);
+    return;
+  }
+  std::unique_ptr<CVolumeMetadata> pre_meta = makeMetadata(pre);
+  std::unique_ptr<CVolumeMetadata> post_meta = makeMetadata(post);
+  vmml::AABB<int64_t> preROI, postROI;
+  getOverlapVolumeROIs(*pre_meta, *post_meta, preROI, postROI);
 
-  google::protobuf::ShutdownProtobufLibrary();
+  pre_volume = makeCompressedVolume(pre, std::move(pre_meta), preROI);
+  post_volume = makeCompressedVolume(post, std::move(post_meta), postROI);
+}
 
+// Volumes of a center and its neighbors. Compressed neighbors keep only their overlap
+// region, a compressed center the bounding box of all of its overlap regions.
+static void makeFaceVolumes(const CInputVolume * center, const CInputVolume * neighbors, uint32_t neighborCount, bool compressed, std::unique_ptr<CVolume> &center_volume, std::vector<std::unique_ptr<CVolume>> &neighbor_volumes) {
+  if (!compressed) {
+    center_volume = makeVolume(center);
+    for (uint32_t i = 0; i < neighborCount; ++i) {
+      neighbor_volumes.push_back(makeVolume(&neighbors[i]));
+    }
+    return;
+  }
+  std::unique_ptr<CVolumeMetadata> center_meta = makeMetadata(center);
+  vmml::AABB<int64_t> centerROI;
+  for (uint32_t i = 0; i < neighborCount; ++i) {
+    std::unique_ptr<CVolumeMetadata> neighbor_meta = makeMetadata(&neighbors[i]);
+    vmml::AABB<int64_t> preROI, postROI;
+    getOverlapVolumeROIs(*center_meta, *neighbor_meta, preROI, postROI);
+    if (!preROI.isEmpty()) {
+      centerROI.merge(preROI);
+    }
+    neighbor_volumes.push_back(makeCompressedVolume(&neighbors[i], std::move(neighbor_meta), postROI));
+  }
+  if (centerROI.isEmpty()) {
+    centerROI = vmml::AABB<int64_t>(vmml::Vector<3, int64_t>(0, 0, 0), vmml::Vector<3, int64_t>(0, 0, 0));
+  }
+  center_volume = makeCompressedVolume(center, std::move(center_meta), centerROI);
+}
+
+static CSpawnTableWrapper * generatePair(CInputVolume * pre, CInputVolume * post, uint32_t threadCount, bool flat, bool compressed) {
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+  std::unique_ptr<CVolume> pre_volume, post_volume;
+  makePairVolumes(pre, post, compressed, pre_volume, post_volume);
+
+  CFlatSpawnTableData flatSpawntable;
+  calcSpawnTable(flatSpawntable, *pre_volume, *post_volume, resolveThreadCount(threadCount));
+
+  std::vector<unsigned char> buffer;
+  writeSpawnTable(flatSpawntable, flat, false, buffer);
+
+  CSpawnTableWrapper * spawntableWrapper = new CSpawnTableWrapper();
+  fillWrapper(*spawntableWrapper, buffer);
   return spawntableWrapper;
 }
 
+static CSpawnTableBatch * generateFaces(CInputVolume * center, CInputVolume * neighbors, uint32_t neighborCount, uint32_t threadCount, bool flat, bool compressed) {
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+  std::unique_ptr<CVolume> center_volume;
+  std::vector<std::unique_ptr<CVolume>> neighbor_volumes;
+  makeFaceVolumes(center, neighbors, neighborCount, compressed, center_volume, neighbor_volumes);
+  std::vector<const CVolume *> neighbor_ptrs;
+  for (const auto &volume : neighbor_volumes) {
+    neighbor_ptrs.push_back(volume.get());
+  }
+
+  std::vector<CFlatSpawnTableData> flatSpawntables;
+  calcSpawnTables(flatSpawntables, *center_volume, neighbor_ptrs, resolveThreadCount(threadCount));
+
+  std::unique_ptr<CSpawnTableBatch> batch(new CSpawnTableBatch(neighborCount));
+  std::vector<unsigned char> buffer;
+  for (uint32_t i = 0; i < neighborCount; ++i) {
+    writeSpawnTable(flatSpawntables[i], flat, false, buffer);
+    fillWrapper(batch->tables[i], buffer);
+  }
+  return batch.release();
+}
+
+// The library never calls google::protobuf::ShutdownProtobufLibrary: it is loaded into
+// long-running workers, and protobuf cannot be used again once shut down. Executables
+// shut it down before they exit.
+
+// Runs generate for an exported entry point. Errors must not unwind into the caller
+// (ctypes, node-ffi), where they would terminate the process: they are logged and
+// nullptr is returned instead.
+template <typename T, typename F>
+static T * guardExport(const char * name, F generate) {
+  try {
+    return generate();
+  } catch (const std::string & err) {
+    std::cout << name << " failed: " << err << "\n";
+  } catch (const std::exception & err) {
+    std::cout << name << " failed: " << err.what() << "\n";
+  }
+  return nullptr;
+}
+
+// Protobuf spawn table of pre towards post, on the calling thread. Callers bind this
+// symbol without checking its arguments, so its signature stays as it is.
+extern "C" CSpawnTableWrapper * SpawnSet_Generate(CInputVolume * pre, CInputVolume * post) {
+  return guardExport<CSpawnTableWrapper>("SpawnSet_Generate", [&]() { return generatePair(pre, post, 1, false, false); });
+}
+
+// Same as SpawnSet_Generate, with the overlap scanned on threadCount threads (0: all cores)
+extern "C" CSpawnTableWrapper * SpawnSet_GenerateThreaded(CInputVolume * pre, CInputVolume * post, uint32_t threadCount) {
+  return guardExport<CSpawnTableWrapper>("SpawnSet_GenerateThreaded", [&]() { return generatePair(pre, post, threadCount, false, false); });
+}
+
+// Same as SpawnSet_GenerateThreaded, but returns the table in the flat format of FlatSpawnTable.h
+extern "C" CSpawnTableWrapper * SpawnSet_GenerateFlat(CInputVolume * pre, CInputVolume * post, uint32_t threadCount) {
+  return guardExport<CSpawnTableWrapper>("SpawnSet_GenerateFlat", [&]() { return generatePair(pre, post, threadCount, true, false); });
+}
+
+// Spawn tables of center towards each of the neighborCount volumes in neighbors, in the
+// same order. The center is parsed once for all of them. flat != 0 selects the flat format.
+extern "C" CSpawnTableBatch * SpawnSet_GenerateFaces(CInputVolume * center, CInputVolume * neighbors, uint32_t neighborCount, uint32_t threadCount, uint32_t flat) {
+  return guardExport<CSpawnTableBatch>("SpawnSet_GenerateFaces", [&]() { return generateFaces(center, neighbors, neighborCount, threadCount, flat != 0, false); });
+}
+
+// Same as SpawnSet_GenerateThreaded (flat == 0) or SpawnSet_GenerateFlat, but the segmentations
+// are passed as segmentation.lzma or segmentation.blocks. Only the overlap region of each
+// volume is kept: LZMA decoding stops at its last z-slice, block segmentations only
+// decompress the blocks it intersects.
+extern "C" CSpawnTableWrapper * SpawnSet_GenerateCompressed(CInputVolume * pre, CInputVolume * post, uint32_t threadCount, uint32_t flat) {
+  return guardExport<CSpawnTableWrapper>("SpawnSet_GenerateCompressed", [&]() { return generatePair(pre, post, threadCount, flat != 0, true); });
+}
+
+// Same as SpawnSet_GenerateFaces, but the segmentations are passed as segmentation.lzma
+// or segmentation.blocks.
+// Neighbors keep only their overlap region, the center the bounding box of all of its
+// overlap regions.
+extern "C" CSpawnTableBatch * SpawnSet_GenerateFacesCompressed(CInputVolume * center, CInputVolume * neighbors, uint32_t neighborCount, uint32_t threadCount, uint32_t flat) {
+  return guardExport<CSpawnTableBatch>("SpawnSet_GenerateFacesCompressed", [&]() { return generateFaces(center, neighbors, neighborCount, threadCount, flat != 0, true); });
+}
+
 extern "C" void SpawnSet_Release(CSpawnTableWrapper * spawntableWrapper) {
   delete spawntableWrapper;
   spawntableWrapper = nullptr;
 }
+
+extern "C" void SpawnSet_ReleaseFaces(CSpawnTableBatch * batch) {
+  delete batch;
+  batch = nullptr;
+}
+
+/*****************************************************************/
+
+// Session of a worker that generates many tables: created once with its thread pool,
+// scratch tables and serialization buffer, used for every request, destroyed at shutdown.
+class CSpawnSession {
+public:
+  CSpawnContext               context;
+  std::vector<unsigned char>  buffer;
+  bool                        sharedPosts;   // protobuf tables as version 3
+
+  explicit CSpawnSession(uint32_t threadCount) : context(resolveThreadCount(threadCount)), sharedPosts(false) { };
+};
+
+// threadCount == 0 uses all cores. Calls on one session must not overlap.
+extern "C" CSpawnSession * SpawnSession_Create(uint32_t threadCount) {
+  return guardExport<CSpawnSession>("SpawnSession_Create", [&]() { return new CSpawnSession(threadCount); });
+}
+
+// sharedPosts != 0 makes the session write protobuf tables as version 3, with every
+// post-side segment stored once. Servers only load those once they read version 3, so
+// sessions write version 1 or 2 until this is set.
+extern "C" void SpawnSession_SetSharedPosts(CSpawnSession * session, uint32_t sharedPosts) {
+  if (!session) {
+    std::cout << "SpawnSession_SetSharedPosts failed: no session.\n";
+    return;
+  }
+  session->sharedPosts = (sharedPosts != 0);
+}
+
+// Same as SpawnSet_GenerateThreaded, SpawnSet_GenerateFlat (flat != 0) or their compressed
+// variants (compressed != 0), on the session's threads. Release with SpawnSet_Release.
+extern "C" CSpawnTableWrapper * SpawnSession_Generate(CSpawnSession * session, CInputVolume * pre, CInputVolume * post, uint32_t flat, uint32_t compressed) {
+  if (!session) {
+    std::cout << "SpawnSession_Generate failed: no session.\n";
+    return nullptr;
+  }
+  return guardExport<CSpawnTableWrapper>("SpawnSession_Generate", [&]() {
+    std::unique_ptr<CVolume> pre_volume, post_volume;
+    makePairVolumes(pre, post, compressed != 0, pre_volume, post_volume);
+
+    CFlatSpawnTableData flatSpawntable;
+    calcSpawnTable(flatSpawntable, *pre_volume, *post_volume, session->context);
+    writeSpawnTable(flatSpawntable, flat != 0, session->sharedPosts, session->buffer);
+
+    CSpawnTableWrapper * spawntableWrapper = new CSpawnTableWrapper();
+    fillWrapper(*spawntableWrapper, session->buffer);
+    return spawntableWrapper;
+  });
+}
+
+// Same as SpawnSet_GenerateFaces or SpawnSet_GenerateFacesCompressed. The faces are
+// processed one after another, each with its slabs spread over all of the session's
+// threads. Release with SpawnSet_ReleaseFaces.
+extern "C" CSpawnTableBatch * SpawnSession_GenerateFaces(CSpawnSession * session, CInputVolume * center, CInputVolume * neighbors, uint32_t neighborCount, uint32_t flat, uint32_t compressed) {
+  if (!session) {
+    std::cout << "SpawnSession_GenerateFaces failed: no session.\n";
+    return nullptr;
+  }
+  return guardExport<CSpawnTableBatch>("SpawnSession_GenerateFaces", [&]() {
+    std::unique_ptr<CVolume> center_volume;
+    std::vector<std::unique_ptr<CVolume>> neighbor_volumes;
+    makeFaceVolumes(center, neighbors, neighborCount, compressed != 0, center_volume, neighbor_volumes);
+
+    std::unique_ptr<CSpawnTableBatch> batch(new CSpawnTableBatch(neighborCount));
+    for (uint32_t i = 0; i < neighborCount; ++i) {
+      CFlatSpawnTableData flatSpawntable;
+      calcSpawnTable(flatSpawntable, *center_volume, *neighbor_volumes[i], session->context);
+      writeSpawnTable(flatSpawntable, flat != 0, session->sharedPosts, session->buffer);
+      fillWrapper(batch->tables[i], session->buffer);
+    }
+    return batch.release();
+  });
+}
+
+extern "C" void SpawnSession_Destroy(CSpawnSession * session) {
+  delete session;
+  session = nullptr;
+}
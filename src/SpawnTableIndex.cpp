@@ -0,0 +1,368 @@
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "SpawnTableIndex.h"
+#include "TaskSpawner.h"
+
+#include "../res/spawnset.pb.h"
+
+using namespace ew;
+
+/*****************************************************************/
+
+CSpawnTableIndex::CSpawnTableIndex(const unsigned char * buffer, size_t length) : mapped_(nullptr), mappedLength_(0), wide_(false) {
+  if (CFlatSpawnTableView::IsFlatSpawnTable(buffer, length)) {
+    storage_.assign(buffer, buffer + length);
+    view(storage_.data(), storage_.size());
+  } else {
+    load(buffer, length);
+  }
+}
+
+CSpawnTableIndex::CSpawnTableIndex(const spawner::SpawnTable & spawntable) : mapped_(nullptr), mappedLength_(0), wide_(false) {
+  load(spawntable);
+}
+
+CSpawnTableIndex::CSpawnTableIndex(const std::string & path) : mapped_(nullptr), mappedLength_(0), wide_(false) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::string("Could not open ") + path;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    close(fd);
+    throw std::string("Could not read ") + path;
+  }
+  void * mapped = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapped == MAP_FAILED) {
+    throw std::string("Could not map ") + path;
+  }
+
+  const unsigned char * buffer = static_cast<const unsigned char *>(mapped);
+  const size_t length = size_t(st.st_size);
+  try {
+    if (CFlatSpawnTableView::IsFlatSpawnTable(buffer, length)) {
+      view(buffer, length);
+      mapped_ = mapped;
+      mappedLength_ = length;
+      return;
+    }
+    load(buffer, length);
+  } catch (...) {
+    munmap(mapped, length);
+    throw;
+  }
+  munmap(mapped, length);
+}
+
+CSpawnTableIndex::~CSpawnTableIndex() {
+  if (mapped_) {
+    munmap(mapped_, mappedLength_);
+    mapped_ = nullptr;
+  }
+}
+
+void CSpawnTableIndex::view(const unsigned char * buffer, size_t length) {
+  wide_ = CFlatSpawnTableView::HasWideIDs(buffer, length);
+  if (wide_) {
+    table64_ = CFlatSpawnTableView64(buffer, length);
+  } else {
+    table_ = CFlatSpawnTableView(buffer, length);
+  }
+}
+
+void CSpawnTableIndex::load(const unsigned char * buffer, size_t length) {
+  spawner::SpawnTable spawntable;
+  if (!spawntable.ParseFromArray(buffer, int(length))) {
+    throw std::string("Failed to parse spawn table.");
+  }
+  load(spawntable);
+}
+
+void CSpawnTableIndex::load(const spawner::SpawnTable & spawntable) {
+  CFlatSpawnTableData data;
+  data.FromSpawnTable(spawntable);
+  data.Write(storage_);
+  view(storage_.data(), storage_.size());
+}
+
+/*****************************************************************/
+
+// Seed query on a flat table view of either ID width
+template <typename ID>
+static void querySeeds(const CFlatSpawnTableViewT<ID> & table, std::vector<std::map<ID, uint32_t>> & seeds, const ID * segments, size_t segmentCount, double matchRatio) {
+  seeds.clear();
+
+  struct Candidate {
+    uint32_t post;
+    bool     canSpawn;
+    int64_t  group;
+  };
+
+  // Retrieve post-side candidates for the selection, in order of first occurrence.
+  // A candidate may spawn if any of the selected pre-side segments allows it to.
+  std::unordered_set<ID> selection;
+  std::vector<Candidate> candidates;
+  std::unordered_map<ID, uint32_t> candidateOf;  // post-side segment ID -> candidate
+  std::vector<uint32_t> posts, sizes;
+  std::vector<ID> ids;
+  std::vector<uint8_t> canSpawns;
+  const ID * preIDsEnd = table.preIDs + table.preCount;
+  for (size_t i = 0; i < segmentCount; ++i) {
+    if (!selection.insert(segments[i]).second) {
+      continue;
+    }
+    const ID * it = std::lower_bound(table.preIDs, preIDsEnd, segments[i]);
+    if (it == preIDsEnd || *it != segments[i]) {
+      continue;
+    }
+    table.GetCounterparts(it - table.preIDs, posts, canSpawns);
+    for (size_t c = 0; c < posts.size(); ++c) {
+      const uint32_t post = posts[c];
+      const bool canSpawn = canSpawns[c] != 0;
+      auto inserted = candidateOf.insert(std::make_pair(table.postIDs[post], uint32_t(candidates.size())));
+      if (inserted.second) {
+        Candidate candidate = { post, canSpawn, -1 };
+        candidates.push_back(candidate);
+      } else if (canSpawn) {
+        candidates[inserted.first->second].canSpawn = true;
+      }
+    }
+  }
+
+  // Region graph edges between candidates, in the order of the neighbor lists. Packed
+  // tables store each edge with its lower segment only; the other direction is added
+  // here and the lists are sorted by segment ID, as neighbor lists are when packed.
+  std::vector<std::vector<uint32_t>> adjacent(candidates.size());
+  const ID * graphIDsEnd = table.graphIDs + table.graphCount;
+  for (uint32_t c = 0; c < candidates.size(); ++c) {
+    const ID postID = table.postIDs[candidates[c].post];
+    const ID * graphEntry = std::lower_bound(table.graphIDs, graphIDsEnd, postID);
+    if (graphEntry == graphIDsEnd || *graphEntry != postID) {
+      continue;
+    }
+    table.GetNeighbors(graphEntry - table.graphIDs, ids);
+    for (ID neighborID : ids) {
+      auto neighbor = candidateOf.find(neighborID);
+      if (neighbor != candidateOf.end()) {
+        adjacent[c].push_back(neighbor->second);
+        if (table.packed) {
+          adjacent[neighbor->second].push_back(c);
+        }
+      }
+    }
+  }
+  if (table.packed) {
+    for (std::vector<uint32_t> & neighbors : adjacent) {
+      std::sort(neighbors.begin(), neighbors.end(), [&](uint32_t a, uint32_t b) {
+        return table.postIDs[candidates[a].post] < table.postIDs[candidates[b].post];
+      });
+    }
+  }
+
+  // Connected components on post-side candidates. The stack (including repeated
+  // visits) follows the JS implementation, so each group lists its segments in the
+  // same order, which decides ties of the best-match fallback below.
+  std::vector<uint32_t> groupOffsets(1, 0);
+  std::vector<uint32_t> groupMembers;
+  std::vector<uint32_t> stack;
+  for (uint32_t c = 0; c < candidates.size(); ++c) {
+    if (candidates[c].group != -1) {
+      continue;
+    }
+
+    const int64_t group = int64_t(groupOffsets.size()) - 1;
+    stack.assign(1, c);
+    while (!stack.empty()) {
+      const uint32_t current = stack.back();
+      stack.pop_back();
+      if (candidates[current].group == -1) {
+        candidates[current].group = group;
+        groupMembers.push_back(current);
+      }
+
+      for (uint32_t neighbor : adjacent[current]) {
+        if (candidates[neighbor].group == -1) {
+          stack.push_back(neighbor);
+        }
+      }
+    }
+    groupOffsets.push_back(uint32_t(groupMembers.size()));
+  }
+
+  // Keep post-side segments with enough coverage by the selection
+  for (size_t group = 0; group + 1 < groupOffsets.size(); ++group) {
+    std::map<ID, uint32_t> seed;
+    bool seedCanSpawn = false;
+
+    const Candidate * bestMatch = nullptr;
+    double bestScore = 0.0;
+    uint64_t bestMappedSize = 0;
+
+    for (uint32_t m = groupOffsets[group]; m < groupOffsets[group + 1]; ++m) {
+      const Candidate & candidate = candidates[groupMembers[m]];
+      const uint32_t overlapSize = table.postOverlapSizes[candidate.post];
+      const double requiredSize = matchRatio * overlapSize;
+
+      uint64_t accumSize = 0;
+      table.GetSupports(candidate.post, ids, sizes);
+      for (size_t s = 0; s < ids.size(); ++s) {
+        if (selection.count(ids[s])) {
+          accumSize += sizes[s];
+        }
+      }
+
+      if (double(accumSize) >= requiredSize) {
+        seed[table.postIDs[candidate.post]] = overlapSize;
+        seedCanSpawn = seedCanSpawn || candidate.canSpawn;
+      }
+
+      // Store best (valid) match in case we don't find a single valid post-segment for this group
+      const double matchScore = (double(accumSize) + 1000.0) / (double(overlapSize) + 2000.0);
+      if (candidate.canSpawn && (!bestMatch || matchScore > bestScore)) {
+        bestMatch = &candidate;
+        bestScore = matchScore;
+        bestMappedSize = accumSize;
+      }
+    }
+
+    // No valid post-segment found (or only no-spawn segments), so add the best match we got (if any)
+    if (bestMatch && !seedCanSpawn) {
+      seed[table.postIDs[bestMatch->post]] = table.postOverlapSizes[bestMatch->post];
+      seedCanSpawn = true;
+      std::cout << "No perfect seed found. Chose seg " << table.postIDs[bestMatch->post] << " with " << bestMappedSize << " / " << table.postOverlapSizes[bestMatch->post] << " voxels matching.\n";
+    }
+
+    // Drop groups that only consist of segments not allowed to spawn (dust, or near boundary)
+    if (seedCanSpawn) {
+      seeds.push_back(std::move(seed));
+    }
+  }
+}
+
+void CSpawnTableIndex::QuerySeeds(std::vector<std::map<uint32_t, uint32_t>> & seeds, const uint32_t * segments, size_t segmentCount, double matchRatio) const {
+  if (!wide_) {
+    querySeeds(table_, seeds, segments, segmentCount, matchRatio);
+    return;
+  }
+
+  std::vector<std::map<uint64_t, uint32_t>> wideSeeds;
+  std::vector<uint64_t> wideSegments(segments, segments + segmentCount);
+  querySeeds(table64_, wideSeeds, wideSegments.data(), wideSegments.size(), matchRatio);
+
+  seeds.clear();
+  for (const std::map<uint64_t, uint32_t> & wideSeed : wideSeeds) {
+    std::map<uint32_t, uint32_t> seed;
+    for (const auto & segment : wideSeed) {
+      if (segment.first > UINT32_MAX) {
+        throw std::string("Seed segment ") + std::to_string(segment.first) + " needs 64-bit IDs.";
+      }
+      seed.emplace_hint(seed.end(), uint32_t(segment.first), segment.second);
+    }
+    seeds.push_back(std::move(seed));
+  }
+}
+
+void CSpawnTableIndex::QuerySeeds(std::vector<std::map<uint64_t, uint32_t>> & seeds, const uint64_t * segments, size_t segmentCount, double matchRatio) const {
+  if (wide_) {
+    querySeeds(table64_, seeds, segments, segmentCount, matchRatio);
+    return;
+  }
+
+  // IDs above 2^32 - 1 cannot be in a 32-bit table
+  std::vector<std::map<uint32_t, uint32_t>> narrowSeeds;
+  std::vector<uint32_t> narrowSegments;
+  for (size_t i = 0; i < segmentCount; ++i) {
+    if (segments[i] <= UINT32_MAX) {
+      narrowSegments.push_back(uint32_t(segments[i]));
+    }
+  }
+  querySeeds(table_, narrowSeeds, narrowSegments.data(), narrowSegments.size(), matchRatio);
+
+  seeds.clear();
+  for (const std::map<uint32_t, uint32_t> & narrowSeed : narrowSeeds) {
+    seeds.push_back(std::map<uint64_t, uint32_t>(narrowSeed.begin(), narrowSeed.end()));
+  }
+}
+
+/*****************************************************************/
+
+// Runs one export. Callers are JS and Python bindings, so no exception may unwind
+// into them: any failure is logged and returned as NULL.
+template<typename T, typename F>
+static T * guardExport(const char * name, F create) {
+  try {
+    return create();
+  } catch (const std::string & err) {
+    std::cout << name << " failed: " << err << "\n";
+  } catch (const std::exception & err) {
+    std::cout << name << " failed: " << err.what() << "\n";
+  }
+  return nullptr;
+}
+
+extern "C" CSpawnTableIndex * SpawnTableIndex_Load(const unsigned char * buffer, uint32_t length) {
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+  return guardExport<CSpawnTableIndex>("SpawnTableIndex_Load", [&]() { return new CSpawnTableIndex(buffer, length); });
+}
+
+extern "C" CSpawnTableIndex * SpawnTableIndex_Open(const char * path) {
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+  return guardExport<CSpawnTableIndex>("SpawnTableIndex_Open", [&]() { return new CSpawnTableIndex(std::string(path)); });
+}
+
+extern "C" CTaskSpawner * SpawnTableIndex_QuerySeeds(const CSpawnTableIndex * index, const uint32_t * segments, uint32_t segmentCount, double matchRatio) {
+  if (!index) {
+    std::cout << "SpawnTableIndex_QuerySeeds failed: no index.\n";
+    return nullptr;
+  }
+
+  return guardExport<CTaskSpawner>("SpawnTableIndex_QuerySeeds", [&]() {
+    std::vector<std::map<uint32_t, uint32_t>> seeds;
+    index->QuerySeeds(seeds, segments, segmentCount, matchRatio);
+
+    return new CTaskSpawner(seeds);
+  });
+}
+
+extern "C" void SpawnTableIndex_ReleaseSeeds(CTaskSpawner * taskspawner) {
+  delete taskspawner;
+  taskspawner = nullptr;
+}
+
+// Same as SpawnTableIndex_QuerySeeds, with 64-bit segment IDs in selection and seeds
+extern "C" CTaskSpawner64 * SpawnTableIndex_QuerySeeds64(const CSpawnTableIndex * index, const uint64_t * segments, uint32_t segmentCount, double matchRatio) {
+  if (!index) {
+    std::cout << "SpawnTableIndex_QuerySeeds64 failed: no index.\n";
+    return nullptr;
+  }
+
+  return guardExport<CTaskSpawner64>("SpawnTableIndex_QuerySeeds64", [&]() {
+    std::vector<std::map<uint64_t, uint32_t>> seeds;
+    index->QuerySeeds(seeds, segments, segmentCount, matchRatio);
+
+    return new CTaskSpawner64(seeds);
+  });
+}
+
+extern "C" void SpawnTableIndex_ReleaseSeeds64(CTaskSpawner64 * taskspawner) {
+  delete taskspawner;
+  taskspawner = nullptr;
+}
+
+extern "C" void SpawnTableIndex_Release(CSpawnTableIndex * index) {
+  delete index;
+  index = nullptr;
+}
@@ -0,0 +1,104 @@
+#include <algorithm>
+
+#include "ThreadPool.h"
+
+/*****************************************************************/
+
+// Pool and deque of the calling thread, if it is a pool worker
+static thread_local const CThreadPool * currentPool = nullptr;
+static thread_local size_t currentQueue = 0;
+
+CThreadPool::CThreadPool(unsigned int threadCount) : queued_(0), pending_(0), nextQueue_(0), stop_(false) {
+  threadCount = std::max(1u, threadCount);
+  for (unsigned int i = 0; i < threadCount; ++i) {
+    queues_.emplace_back(new CWorkerQueue());
+  }
+  for (unsigned int i = 0; i < threadCount; ++i) {
+    threads_.emplace_back(&CThreadPool::work, this, size_t(i));
+  }
+}
+
+CThreadPool::~CThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (auto &thread : threads_) {
+    thread.join();
+  }
+}
+
+void CThreadPool::Submit(std::function<void()> task) {
+  const size_t index = (currentPool == this) ? currentQueue : nextQueue_++ % queues_.size();
+
+  ++pending_;
+  {
+    // Counted under mutex_, so an idle worker cannot miss it between check and wait, and
+    // before the task is published, so a worker taking it cannot decrement below zero
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++queued_;
+  }
+  {
+    std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+    queues_[index]->tasks.push_back(std::move(task));
+  }
+  wake_.notify_one();
+}
+
+void CThreadPool::Wait() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_.wait(lock, [this]() { return pending_ == 0; });
+}
+
+/*****************************************************************/
+
+bool CThreadPool::pop(size_t index, std::function<void()> &task) {
+  CWorkerQueue &queue = *queues_[index];
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  if (queue.tasks.empty()) {
+    return false;
+  }
+  task = std::move(queue.tasks.back());
+  queue.tasks.pop_back();
+  return true;
+}
+
+bool CThreadPool::steal(size_t index, std::function<void()> &task) {
+  for (size_t i = 1; i < queues_.size(); ++i) {
+    CWorkerQueue &queue = *queues_[(index + i) % queues_.size()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+void CThreadPool::work(size_t index) {
+  currentPool = this;
+  currentQueue = index;
+
+  while (true) {
+    std::function<void()> task;
+    if (pop(index, task) || steal(index, task)) {
+      --queued_;
+      task();
+      task = nullptr;
+
+      if (--pending_ == 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        done_.notify_all();
+      }
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    wake_.wait(lock, [this]() { return stop_ || queued_ > 0; });
+    if (stop_ && queued_ == 0) {
+      return;
+    }
+  }
+}
@@ -1,7 +1,12 @@
-#include "Volume.h"
-#include "json.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
 
-using json = nlohmann::json;
+#include "Volume.h"
+#include "BlockSegmentation.h"
+#include "LZMA.h"
+#include "MetadataReader.h"
+#include "PaletteSegmentation.h"
 
 /*****************************************************************/
 
@@ -18,14 +23,33 @@ MetaDataType StringToMetaDataType(const std::string & str, uint8_t * sizeInByte)
     if (sizeInByte) *sizeInByte = 4;
     return MetaDataType::UInt32;
   }
+  else if (str == "UInt64") {
+    if (sizeInByte) *sizeInByte = 8;
+    return MetaDataType::UInt64;
+  }
   else {
-    throw(std::string("Unsupported type '" + str + "'. Must be UInt8, UInt16, UInt32, Float32 or Float64."));
+    throw(std::string("Unsupported type '" + str + "'. Must be UInt8, UInt16, UInt32, UInt64, Float32 or Float64."));
   }
 }
 
 /*****************************************************************/
 
-vmml::AABB<int64_t> CVolume::empty_bbox = vmml::AABB<int64_t>();
+uint8_t MetaDataTypeSize(MetaDataType type) {
+  switch (type) {
+  case MetaDataType::UInt8:
+    return 1;
+  case MetaDataType::UInt16:
+    return 2;
+  case MetaDataType::UInt32:
+  case MetaDataType::Float32:
+    return 4;
+  case MetaDataType::UInt64:
+  case MetaDataType::Float64:
+    return 8;
+  default:
+    return 0;
+  }
+}
 
 /*****************************************************************/
 
@@ -33,79 +57,145 @@ CSegmentation::CSegmentation(const vmml::Vector<3, int64_t> &dimensions) : dimen
 {
 }
 
-uint32_t CSegmentation::operator()(int64_t x, int64_t y, int64_t z) const {
+CSegmentation::~CSegmentation()
+{
+}
+
+uint64_t CSegmentation::operator()(int64_t x, int64_t y, int64_t z) const {
   return 0;
 }
 
-uint32_t CSegmentation::operator()(const vmml::Vector<3, int64_t> & pos) const {
+uint64_t CSegmentation::operator()(const vmml::Vector<3, int64_t> & pos) const {
   return 0;
 }
 
 /*****************************************************************/
 
-CSegmentationUChar::CSegmentationUChar(const vmml::Vector<3, int64_t> &dimensions, const uint8_t * segmentation) :
+CSegmentationUChar::CSegmentationUChar(const vmml::Vector<3, int64_t> &dimensions, const CSegmentationView<uint8_t> &segmentation) :
   CSegmentation(dimensions),
   segmentation_(segmentation)
 {
 }
 
-uint32_t CSegmentationUChar::operator()(int64_t x, int64_t y, int64_t z) const {
-  return segmentation_[x + y * dimensions_.x() + z * dimensions_.x() * dimensions_.y()];
+uint64_t CSegmentationUChar::operator()(int64_t x, int64_t y, int64_t z) const {
+  return segmentation_(x, y, z);
 }
 
-uint32_t CSegmentationUChar::operator()(const vmml::Vector<3, int64_t> & pos) const {
-  return segmentation_[pos.x() + pos.y() * dimensions_.x() + pos.z() * dimensions_.x() * dimensions_.y()];
+uint64_t CSegmentationUChar::operator()(const vmml::Vector<3, int64_t> & pos) const {
+  return segmentation_(pos);
 }
 
 /*****************************************************************/
 
-CSegmentationUShort::CSegmentationUShort(const vmml::Vector<3, int64_t> &dimensions, const uint16_t * segmentation) :
+CSegmentationUShort::CSegmentationUShort(const vmml::Vector<3, int64_t> &dimensions, const CSegmentationView<uint16_t> &segmentation) :
   CSegmentation(dimensions),
   segmentation_(segmentation)
 {
 }
 
-uint32_t CSegmentationUShort::operator()(int64_t x, int64_t y, int64_t z) const {
-  return segmentation_[x + y * dimensions_.x() + z * dimensions_.x() * dimensions_.y()];
+uint64_t CSegmentationUShort::operator()(int64_t x, int64_t y, int64_t z) const {
+  return segmentation_(x, y, z);
 }
 
-uint32_t CSegmentationUShort::operator()(const vmml::Vector<3, int64_t> & pos) const {
-  return segmentation_[pos.x() + pos.y() * dimensions_.x() + pos.z() * dimensions_.x() * dimensions_.y()];
+uint64_t CSegmentationUShort::operator()(const vmml::Vector<3, int64_t> & pos) const {
+  return segmentation_(pos);
 }
 
 /*****************************************************************/
 
-CSegmentationUInt::CSegmentationUInt(const vmml::Vector<3, int64_t> &dimensions, const uint32_t * segmentation) :
+CSegmentationUInt::CSegmentationUInt(const vmml::Vector<3, int64_t> &dimensions, const CSegmentationView<uint32_t> &segmentation) :
   CSegmentation(dimensions),
   segmentation_(segmentation)
 {
 }
 
-uint32_t CSegmentationUInt::operator()(int64_t x, int64_t y, int64_t z) const {
-  return segmentation_[x + y * dimensions_.x() + z * dimensions_.x() * dimensions_.y()];
+uint64_t CSegmentationUInt::operator()(int64_t x, int64_t y, int64_t z) const {
+  return segmentation_(x, y, z);
 }
 
-uint32_t CSegmentationUInt::operator()(const vmml::Vector<3, int64_t> & pos) const {
-  return segmentation_[pos.x() + pos.y() * dimensions_.x() + pos.z() * dimensions_.x() * dimensions_.y()];
+uint64_t CSegmentationUInt::operator()(const vmml::Vector<3, int64_t> & pos) const {
+  return segmentation_(pos);
 }
 
 /*****************************************************************/
 
-CVolume::CVolume(std::unique_ptr<CVolumeMetadata> &&meta, const std::vector<unsigned char> &raw_segmentation) :
-    meta_(std::move(meta))
+CSegmentationULong::CSegmentationULong(const vmml::Vector<3, int64_t> &dimensions, const CSegmentationView<uint64_t> &segmentation) :
+  CSegmentation(dimensions),
+  segmentation_(segmentation)
 {
-  switch (meta_->segment_id_type) {
-  case MetaDataType::UInt8:
-    segmentation_ = new CSegmentationUChar(meta_->volume_dimensions, reinterpret_cast<const uint8_t *>(raw_segmentation.data()));
-    break;
-  case MetaDataType::UInt16:
-    segmentation_ = new CSegmentationUShort(meta_->volume_dimensions, reinterpret_cast<const uint16_t *>(raw_segmentation.data()));
-    break;
-  case MetaDataType::UInt32:
-    segmentation_ = new CSegmentationUInt(meta_->volume_dimensions, reinterpret_cast<const uint32_t *>(raw_segmentation.data()));
-    break;
+}
+
+uint64_t CSegmentationULong::operator()(int64_t x, int64_t y, int64_t z) const {
+  return segmentation_(x, y, z);
+}
+
+uint64_t CSegmentationULong::operator()(const vmml::Vector<3, int64_t> & pos) const {
+  return segmentation_(pos);
+}
+
+/*****************************************************************/
+
+CSegmentationPalette::CSegmentationPalette(const vmml::Vector<3, int64_t> &dimensions, const CPaletteSegmentation &segmentation) :
+  CSegmentation(dimensions),
+  segmentation_(segmentation)
+{
+}
+
+uint64_t CSegmentationPalette::operator()(int64_t x, int64_t y, int64_t z) const {
+  return segmentation_(x, y, z);
+}
+
+uint64_t CSegmentationPalette::operator()(const vmml::Vector<3, int64_t> & pos) const {
+  return segmentation_(pos.x(), pos.y(), pos.z());
+}
+
+/*****************************************************************/
+
+CVolume::CVolume(std::unique_ptr<CVolumeMetadata> &&meta, const CBufferView &raw_segmentation) :
+    meta_(std::move(meta)),
+    raw_segmentation_(raw_segmentation.data),
+    resident_bounds_(vmml::Vector<3, int64_t>(0, 0, 0), meta_->volume_dimensions),
+    segmentation_(nullptr)
+{
+  if (raw_segmentation.length < GetSegmentationByteSize()) {
+    throw(std::string("Segmentation buffer is smaller than the volume dimensions given in the metadata."));
   }
 
+  createSegmentation();
+}
+
+/*****************************************************************/
+
+CVolume::CVolume(std::unique_ptr<CVolumeMetadata> &&meta, const CBufferView &compressed_segmentation, const vmml::AABB<int64_t> &bounds) :
+    meta_(std::move(meta)),
+    raw_segmentation_(nullptr),
+    segmentation_(nullptr)
+{
+  const vmml::Vector<3, int64_t> & dims = meta_->volume_dimensions;
+  vmml::Vector<3, int64_t> min, max;
+  for (int axis = 0; axis < 3; ++axis) {
+    min[axis] = std::min(std::max<int64_t>(bounds.getMin()[axis], 0), dims[axis]);
+    max[axis] = std::min(std::max<int64_t>(bounds.getMax()[axis], min[axis]), dims[axis]);
+  }
+  resident_bounds_ = vmml::AABB<int64_t>(min, max);
+
+  owned_segmentation_.resize(GetSegmentationByteSize());
+  raw_segmentation_ = owned_segmentation_.data();
+
+  if (CBlockSegmentationReader::IsBlockSegmentation(compressed_segmentation)) {
+    readBlocks(compressed_segmentation);
+  } else {
+    readLZMA(compressed_segmentation);
+  }
+
+  createSegmentation();
+}
+
+/*****************************************************************/
+
+CVolume::CVolume(std::unique_ptr<CVolumeMetadata> &&meta, const std::vector<unsigned char> &raw_segmentation) :
+    CVolume(std::move(meta), CBufferView(raw_segmentation))
+{
 }
 
 /*****************************************************************/
@@ -141,29 +231,32 @@ int64_t CVolume::GetSegmentMaxId() const {
 
 /*****************************************************************/
 
-const vmml::AABB<int64_t> & CVolume::GetSegmentBoundsVolume(int64_t segID) const {
-    if (segID <= GetSegmentMaxId())
-        return meta_->segments->boundsVolume[segID];
-    else
-        return empty_bbox;
+vmml::AABB<int64_t> CVolume::GetSegmentBoundsVolume(int64_t segID) const {
+    return meta_->GetSegmentBoundsVolume(uint64_t(segID));
 }
 
 /*****************************************************************/
 
-const vmml::AABB<int64_t> & CVolume::GetSegmentBoundsWorld(int64_t segID) const {
-    if (segID <= GetSegmentMaxId())
-        return meta_->segments->boundsWorld[segID];
-    else
-        return empty_bbox;
+vmml::AABB<int64_t> CVolume::GetSegmentBoundsWorld(int64_t segID) const {
+    return meta_->GetSegmentBoundsWorld(uint64_t(segID));
 }
 
 /*****************************************************************/
 
 int64_t CVolume::GetSegmentSizeVoxel(int64_t segID) const {
-    if (segID <= GetSegmentMaxId())
-        return meta_->segments->sizes[segID];
-    else
-        return 0;
+    return meta_->GetSegmentSizeVoxel(uint64_t(segID));
+}
+
+/*****************************************************************/
+
+MetaDataType CVolume::GetSegmentIdType() const {
+  return meta_->segment_id_type;
+}
+
+/*****************************************************************/
+
+const CVolumeMetadata & CVolume::GetMetadata() const {
+  return *meta_;
 }
 
 /*****************************************************************/
@@ -174,94 +267,228 @@ const CSegmentation * CVolume::GetSegmentation() const {
 
 /*****************************************************************/
 
-CVolumeMetadata::CSegments::CSegments(const CVolumeMetadata &meta, const std::vector<unsigned char> &raw_bboxes, const std::vector<unsigned char> &raw_sizes) {
-  count = meta.segment_max_id + 1;
+const vmml::AABB<int64_t> & CVolume::GetResidentBounds() const {
+  return resident_bounds_;
+}
 
-  sizes.reserve(count);
-  boundsVolume.reserve(count);
-  boundsWorld.reserve(count);
+/*****************************************************************/
 
-  switch (meta.segment_size_type) {
-    case MetaDataType::UInt8: {
-      const uint8_t * data = reinterpret_cast<const uint8_t *>(raw_sizes.data());
-      sizes.insert(sizes.end(), &data[0], &data[count]);
-      break;
-    }
-    case MetaDataType::UInt16: {
-      const uint16_t * data = reinterpret_cast<const uint16_t *>(raw_sizes.data());
-      sizes.insert(sizes.end(), &data[0], &data[count]);
-      break;
-    }
-    case MetaDataType::UInt32: {
-      const uint32_t * data = reinterpret_cast<const uint32_t *>(raw_sizes.data());
-      sizes.insert(sizes.end(), &data[0], &data[count]);
-      break;
-    }
+size_t CVolume::GetSegmentationByteSize() const {
+  if (palette_) {
+    return palette_->GetByteSize();
   }
-        
-  switch (meta.segment_bbox_type) {
-    case MetaDataType::UInt8: {
-      const uint8_t * data = reinterpret_cast<const uint8_t *>(raw_bboxes.data());
-      for (int i = 0; i < count; ++i) {
-        vmml::Vector<3, int64_t> min(data[6*i+0], data[6*i+1], data[6*i+2]);
-        vmml::Vector<3, int64_t> max(data[6*i+3], data[6*i+4], data[6*i+5]);
-
-        boundsVolume.push_back(vmml::AABB<int64_t>(min, max));
-        boundsWorld.push_back(vmml::AABB<int64_t>(min * meta.voxel_resolution + meta.physical_offset.getMin(), max * meta.voxel_resolution + meta.physical_offset.getMin()));
-      }
-      break;
-    }
-    case MetaDataType::UInt16: {
-      const uint16_t * data = reinterpret_cast<const uint16_t *>(raw_bboxes.data());
-      for (int i = 0; i < count; ++i) {
-        vmml::Vector<3, int64_t> min(data[6*i+0], data[6*i+1], data[6*i+2]);
-        vmml::Vector<3, int64_t> max(data[6*i+3], data[6*i+4], data[6*i+5]);
-
-        boundsVolume.push_back(vmml::AABB<int64_t>(min, max));
-        boundsWorld.push_back(vmml::AABB<int64_t>(min * meta.voxel_resolution + meta.physical_offset.getMin(), max * meta.voxel_resolution + meta.physical_offset.getMin()));
-      }
-      break;
+  const vmml::Vector<3, int64_t> dims = resident_bounds_.getDimension();
+  return size_t(dims.x() * dims.y() * dims.z() * meta_->segment_id_type_size);
+}
+
+/*****************************************************************/
+
+void CVolume::ConvertToPalette() {
+  if (palette_) {
+    return;
+  }
+
+  switch (meta_->segment_id_type) {
+  case MetaDataType::UInt8:
+    palette_.reset(new CPaletteSegmentation(GetSegmentationView<uint8_t>(), resident_bounds_));
+    break;
+  case MetaDataType::UInt16:
+    palette_.reset(new CPaletteSegmentation(GetSegmentationView<uint16_t>(), resident_bounds_));
+    break;
+  case MetaDataType::UInt32:
+    palette_.reset(new CPaletteSegmentation(GetSegmentationView<uint32_t>(), resident_bounds_));
+    break;
+  case MetaDataType::UInt64:
+    throw(std::string("Palette encoding supports segment IDs of up to 32 bits."));
+  default:
+    throw(std::string("Unsupported segment ID type."));
+  }
+
+  delete segmentation_;
+  segmentation_ = new CSegmentationPalette(meta_->volume_dimensions, *palette_);
+  std::vector<unsigned char>().swap(owned_segmentation_);
+  raw_segmentation_ = nullptr;
+}
+
+/*****************************************************************/
+
+const CPaletteSegmentation * CVolume::GetPaletteSegmentation() const {
+  return palette_.get();
+}
+
+/*****************************************************************/
+
+void CVolume::readLZMA(const CBufferView &lzma_segmentation) {
+  const vmml::Vector<3, int64_t> & dims = meta_->volume_dimensions;
+  const vmml::Vector<3, int64_t> & min = resident_bounds_.getMin();
+  const vmml::Vector<3, int64_t> & max = resident_bounds_.getMax();
+
+  const size_t voxelSize = meta_->segment_id_type_size;
+  const size_t sliceSize = size_t(dims.x() * dims.y()) * voxelSize;
+  const size_t rowSize = size_t(max.x() - min.x()) * voxelSize;
+  const bool wholeSlices = (min.x() == 0 && max.x() == dims.x() && min.y() == 0 && max.y() == dims.y());
+
+  // Slices before the bounds are decoded into scratch and dropped. Slices within are
+  // decoded in place if they are kept whole, otherwise their rows inside bounds are copied.
+  CLZMADecoder decoder(lzma_segmentation);
+  std::vector<unsigned char> slice(min.z() > 0 || !wholeSlices ? sliceSize : 0);
+  unsigned char * out = owned_segmentation_.data();
+  const int64_t zEnd = (GetSegmentationByteSize() > 0) ? max.z() : 0;
+  for (int64_t z = 0; z < zEnd; ++z) {
+    const bool direct = (z >= min.z() && wholeSlices);
+    if (decoder.Read(direct ? out : slice.data(), sliceSize) < sliceSize) {
+      throw(std::string("Segmentation is smaller than the volume dimensions given in the metadata."));
     }
-    case MetaDataType::UInt32: {
-      const uint32_t * data = reinterpret_cast<const uint32_t *>(raw_bboxes.data());
-      for (int i = 0; i < count; ++i) {
-        vmml::Vector<3, int64_t> min(data[6*i+0], data[6*i+1], data[6*i+2]);
-        vmml::Vector<3, int64_t> max(data[6*i+3], data[6*i+4], data[6*i+5]);
-
-        boundsVolume.push_back(vmml::AABB<int64_t>(min, max));
-        boundsWorld.push_back(vmml::AABB<int64_t>(min * meta.voxel_resolution + meta.physical_offset.getMin(), max * meta.voxel_resolution + meta.physical_offset.getMin()));
+    if (direct) {
+      out += sliceSize;
+    } else if (z >= min.z()) {
+      for (int64_t y = min.y(); y < max.y(); ++y) {
+        memcpy(out, slice.data() + (size_t(y * dims.x() + min.x()) * voxelSize), rowSize);
+        out += rowSize;
       }
-      break;
     }
   }
 }
 
 /*****************************************************************/
 
-CVolumeMetadata::CVolumeMetadata(const std::vector<unsigned char> &raw_json, const std::vector<unsigned char> &raw_bboxes, const std::vector<unsigned char> &raw_sizes) {
-  auto metadata = json::parse(std::string(raw_json.begin(), raw_json.end()));
-  auto tmpVec = metadata["physical_offset_min"];
-  physical_offset.setMin(vmml::Vector<3, int64_t>(tmpVec[0], tmpVec[1], tmpVec[2]));
+void CVolume::readBlocks(const CBufferView &block_segmentation) {
+  CBlockSegmentationReader reader(block_segmentation);
+  if (reader.GetDimensions() != meta_->volume_dimensions || reader.GetVoxelSize() != meta_->segment_id_type_size) {
+    throw(std::string("Block segmentation does not match the volume dimensions and segment ID type given in the metadata."));
+  }
+  reader.Read(resident_bounds_, owned_segmentation_.data());
+}
 
-  tmpVec = metadata["physical_offset_max"];
-  physical_offset.setMax(vmml::Vector<3, int64_t>(tmpVec[0], tmpVec[1], tmpVec[2]));
+/*****************************************************************/
 
-  tmpVec = metadata["chunk_voxel_dimensions"];
-  volume_dimensions = vmml::Vector<3, int64_t>(tmpVec[0], tmpVec[1], tmpVec[2]);
+void CVolume::createSegmentation() {
+  switch (meta_->segment_id_type) {
+  case MetaDataType::UInt8:
+    segmentation_ = new CSegmentationUChar(meta_->volume_dimensions, GetSegmentationView<uint8_t>());
+    break;
+  case MetaDataType::UInt16:
+    segmentation_ = new CSegmentationUShort(meta_->volume_dimensions, GetSegmentationView<uint16_t>());
+    break;
+  case MetaDataType::UInt32:
+    segmentation_ = new CSegmentationUInt(meta_->volume_dimensions, GetSegmentationView<uint32_t>());
+    break;
+  case MetaDataType::UInt64:
+    segmentation_ = new CSegmentationULong(meta_->volume_dimensions, GetSegmentationView<uint64_t>());
+    break;
+  }
+}
 
-  tmpVec = metadata["voxel_resolution"];
-  voxel_resolution = vmml::Vector<3, int64_t>(tmpVec[0], tmpVec[1], tmpVec[2]);
+/*****************************************************************/
 
-  resolution_units = metadata["resolution_units"];
+// Element at index of an ID, size or bbox array of the given type
+static inline int64_t readValue(const unsigned char * data, MetaDataType type, int64_t index) {
+  switch (type) {
+  case MetaDataType::UInt8:
+    return reinterpret_cast<const uint8_t *>(data)[index];
+  case MetaDataType::UInt16:
+    return reinterpret_cast<const uint16_t *>(data)[index];
+  case MetaDataType::UInt32:
+    return reinterpret_cast<const uint32_t *>(data)[index];
+  case MetaDataType::UInt64:
+    return int64_t(reinterpret_cast<const uint64_t *>(data)[index]);
+  default:
+    return 0;
+  }
+}
 
-  uint8_t size_type_size;
-  segment_id_type = StringToMetaDataType(metadata["segment_id_type"], &segment_id_type_size);
-  segment_bbox_type = StringToMetaDataType(metadata["bounding_box_type"]);
-  segment_size_type = StringToMetaDataType(metadata["size_type"], &size_type_size);
-  segment_count = metadata["num_segments"];
-  segment_max_id = raw_sizes.size() / size_type_size - 1;
+/*****************************************************************/
 
-  segments = new CSegments(*this, raw_bboxes, raw_sizes);
+// Entry of segID in the ascending ID array ids, -1 if not listed
+template <typename T>
+static int64_t findID(const unsigned char * ids, int64_t count, uint64_t segID) {
+  if (segID > std::numeric_limits<T>::max()) {
+    return -1;
+  }
+  const T * begin = reinterpret_cast<const T *>(ids);
+  const T * end = begin + count;
+  const T * it = std::lower_bound(begin, end, T(segID));
+  return (it != end && *it == segID) ? int64_t(it - begin) : -1;
+}
+
+/*****************************************************************/
+
+// Only takes the buffers; entries are decoded when queried
+CVolumeMetadata::CSegments::CSegments(const CVolumeMetadata &meta, const CBufferView &raw_ids, const CBufferView &raw_bboxes, const CBufferView &raw_sizes) :
+  idType(meta.segment_id_type),
+  compacted(false),
+  ids(raw_ids.data),
+  sizes(raw_sizes.data),
+  bboxes(raw_bboxes.data),
+  count(int64_t(raw_sizes.length / meta.segment_size_type_size))
+{
+  if (raw_bboxes.length < size_t(count) * 6 * meta.segment_bbox_type_size) {
+    throw(std::string("Segment bounding boxes do not cover all segment sizes."));
+  }
+  if (ids && raw_ids.length / meta.segment_id_type_size != size_t(count)) {
+    throw(std::string("Sparse segment metadata needs one size and bounding box per segment ID."));
+  }
+}
+
+/*****************************************************************/
+
+int64_t CVolumeMetadata::CSegments::Find(uint64_t segID) const {
+  if (!ids || count == 0) {
+    return segID < uint64_t(count) ? int64_t(segID) : -1;
+  }
+  switch (idType) {
+  case MetaDataType::UInt8:
+    return findID<uint8_t>(ids, count, segID);
+  case MetaDataType::UInt16:
+    return findID<uint16_t>(ids, count, segID);
+  case MetaDataType::UInt32:
+    return findID<uint32_t>(ids, count, segID);
+  case MetaDataType::UInt64:
+    return findID<uint64_t>(ids, count, segID);
+  default:
+    return -1;
+  }
+}
+
+/*****************************************************************/
+
+CVolumeMetadata::CVolumeMetadata(const CBufferView &raw_json, const CBufferView &raw_bboxes, const CBufferView &raw_sizes) :
+  CVolumeMetadata(raw_json, CBufferView(), raw_bboxes, raw_sizes)
+{
+}
+
+/*****************************************************************/
+
+CVolumeMetadata::CVolumeMetadata(const CBufferView &raw_json, const CBufferView &raw_ids, const CBufferView &raw_bboxes, const CBufferView &raw_sizes) {
+  CMetadataFields fields;
+  readMetadata(raw_json, fields);
+  physical_offset.setMin(fields.physicalOffsetMin);
+  physical_offset.setMax(fields.physicalOffsetMax);
+  volume_dimensions = fields.chunkVoxelDimensions;
+  voxel_resolution = fields.voxelResolution;
+  resolution_units = fields.resolutionUnits;
+
+  segment_id_type = fields.segmentIdType;
+  segment_bbox_type = fields.boundingBoxType;
+  segment_size_type = fields.sizeType;
+  segment_id_type_size = MetaDataTypeSize(segment_id_type);
+  segment_bbox_type_size = MetaDataTypeSize(segment_bbox_type);
+  segment_size_type_size = MetaDataTypeSize(segment_size_type);
+  segment_count = fields.numSegments;
+
+  segments = new CSegments(*this, raw_ids, raw_bboxes, raw_sizes);
+  if (segments->ids) {
+    segment_max_id = segments->count ? readValue(segments->ids, segment_id_type, segments->count - 1) : -1;
+  } else {
+    segment_max_id = int64_t(raw_sizes.length / segment_size_type_size) - 1;
+  }
+}
+
+/*****************************************************************/
+
+CVolumeMetadata::CVolumeMetadata(const std::vector<unsigned char> &raw_json, const std::vector<unsigned char> &raw_bboxes, const std::vector<unsigned char> &raw_sizes) :
+  CVolumeMetadata(CBufferView(raw_json), CBufferView(raw_bboxes), CBufferView(raw_sizes))
+{
 }
 
 /*****************************************************************/
@@ -311,4 +538,93 @@ int64_t CVolumeMetadata::GetSegmentMaxId() const {
     return segment_max_id;
 }
 
+/*****************************************************************/
+
+int64_t CVolumeMetadata::GetSegmentSizeVoxel(uint64_t segID) const {
+  const int64_t i = segments->Find(segID);
+  return i < 0 ? 0 : readValue(segments->sizes, segment_size_type, i);
+}
+
+/*****************************************************************/
+
+// Bounds of entry i of a bbox array of the given type, min corner first
+static vmml::AABB<int64_t> readBounds(const unsigned char * bboxes, MetaDataType type, int64_t i) {
+  vmml::Vector<3, int64_t> min(readValue(bboxes, type, 6*i+0), readValue(bboxes, type, 6*i+1), readValue(bboxes, type, 6*i+2));
+  vmml::Vector<3, int64_t> max(readValue(bboxes, type, 6*i+3), readValue(bboxes, type, 6*i+4), readValue(bboxes, type, 6*i+5));
+  return vmml::AABB<int64_t>(min, max);
+}
+
+vmml::AABB<int64_t> CVolumeMetadata::GetSegmentBoundsVolume(uint64_t segID) const {
+  const int64_t i = segments->Find(segID);
+  return i < 0 ? vmml::AABB<int64_t>() : readBounds(segments->bboxes, segment_bbox_type, i);
+}
+
+/*****************************************************************/
+
+vmml::AABB<int64_t> CVolumeMetadata::GetSegmentBoundsWorld(uint64_t segID) const {
+  const int64_t i = segments->Find(segID);
+  if (i < 0) {
+    return vmml::AABB<int64_t>();
+  }
+  const vmml::AABB<int64_t> bounds = readBounds(segments->bboxes, segment_bbox_type, i);
+  return vmml::AABB<int64_t>(bounds.getMin() * voxel_resolution + physical_offset.getMin(), bounds.getMax() * voxel_resolution + physical_offset.getMin());
+}
+
+/*****************************************************************/
+
+bool CVolumeMetadata::IsSparse() const {
+  return segments->ids != nullptr || segments->compacted;
+}
+
+/*****************************************************************/
+
+void CVolumeMetadata::CompactSegments() {
+  CSegments &seg = *segments;
+  if (IsSparse()) {
+    return;
+  }
+
+  const size_t idBytes = segment_id_type_size;
+  const size_t sizeBytes = segment_size_type_size;
+  const size_t bboxBytes = 6 * size_t(segment_bbox_type_size);
+  int64_t present = 0;
+  for (int64_t i = 0; i < seg.count; ++i) {
+    present += readValue(seg.sizes, segment_size_type, i) != 0;
+  }
+  if (present * int64_t(idBytes + sizeBytes + bboxBytes) * 2 >= seg.count * int64_t(sizeBytes + bboxBytes)) {
+    return;
+  }
+
+  seg.ownedIds.resize(size_t(present) * idBytes);
+  seg.ownedSizes.resize(size_t(present) * sizeBytes);
+  seg.ownedBboxes.resize(size_t(present) * bboxBytes);
+  size_t n = 0;
+  for (int64_t i = 0; i < seg.count; ++i) {
+    if (readValue(seg.sizes, segment_size_type, i) != 0) {
+      const uint64_t segID = uint64_t(i);
+      memcpy(seg.ownedIds.data() + n * idBytes, &segID, idBytes);   // little endian, as the files
+      memcpy(seg.ownedSizes.data() + n * sizeBytes, seg.sizes + size_t(i) * sizeBytes, sizeBytes);
+      memcpy(seg.ownedBboxes.data() + n * bboxBytes, seg.bboxes + size_t(i) * bboxBytes, bboxBytes);
+      ++n;
+    }
+  }
+  seg.compacted = true;
+  seg.ids = seg.ownedIds.data();
+  seg.sizes = seg.ownedSizes.data();
+  seg.bboxes = seg.ownedBboxes.data();
+  seg.count = present;
+}
+
+/*****************************************************************/
+
+bool CVolumeMetadata::OwnsSegmentArrays() const {
+  return segments->compacted;
+}
+
+/*****************************************************************/
+
+size_t CVolumeMetadata::GetByteSize() const {
+  return segments->ownedIds.size() + segments->ownedSizes.size() + segments->ownedBboxes.size();
+}
+
 /*****************************************************************/
\ No newline at end of file
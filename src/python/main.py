@@ -1,4 +1,5 @@
 import os
+import collections
 import multiprocessing
 import cPickle as pickle
 
@@ -30,7 +31,7 @@ def worker_main(queue):
         else:
             print("Processing task {}/{}".format(task["id"], total_tasks))
             os.sys.stdout.flush()
-            worker.calcSpawnTable(task["bucket"], task["pre"], task["post"])
+            worker.calcSpawnTables(task["bucket"], task["center"], task["neighbors"])
 
 
 
@@ -42,7 +43,12 @@ def main():
     os.sys.stdout.flush()
 
     bucket, tasks = retrieve_tasks(11)
-    total_tasks = len(tasks)
+
+    # One task per center chunk, so each chunk is loaded once for all its neighbors
+    centers = collections.OrderedDict()
+    for center_path, neighbor_path in tasks:
+        centers.setdefault(center_path, []).append(neighbor_path)
+    total_tasks = len(centers)
 
     print("Done. Found {} tasks".format(total_tasks))
     os.sys.stdout.flush()
@@ -52,12 +58,12 @@ def main():
     pool = multiprocessing.Pool(WORKERS, worker_main, (queue,))
 
     task_cnt = 0
-    for center_path, neighbor_path in tasks:
+    for center_path, neighbor_paths in centers.items():
         params = {
             "id": task_cnt,
             "bucket": bucket,
-            "pre": center_path,
-            "post": neighbor_path
+            "center": center_path,
+            "neighbors": neighbor_paths
         }
         queue.put(params)
         task_cnt += 1
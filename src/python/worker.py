@@ -26,9 +26,39 @@ class SpawnTableWrapper(Structure):
 
 PSpawnTableWrapper = POINTER(SpawnTableWrapper)
 
+class SpawnTableBatch(Structure):
+    _fields_ = [("tableCount", c_uint),
+                ("tables", PSpawnTableWrapper)]
+
+PSpawnTableBatch = POINTER(SpawnTableBatch)
+
+lib.SpawnSet_GenerateFaces.restype = PSpawnTableBatch
+lib.SpawnSet_GenerateFacesCompressed.restype = PSpawnTableBatch
+lib.SpawnSession_Create.restype = c_void_p
+lib.SpawnSession_SetSharedPosts.argtypes = [c_void_p, c_uint]
+lib.SpawnSession_Generate.argtypes = [c_void_p, c_void_p, c_void_p, c_uint, c_uint]
+lib.SpawnSession_Generate.restype = PSpawnTableWrapper
+lib.SpawnSession_GenerateFaces.argtypes = [c_void_p, c_void_p, c_void_p, c_uint, c_uint, c_uint]
+lib.SpawnSession_GenerateFaces.restype = PSpawnTableBatch
+
 TMPDIR = "/tmp/"
+SPAWN_THREADS = 1 # threads per spawn table; main.py already runs one worker process per core
+SPAWN_TABLE_FORMATS = [".pb.spawn"] # add ".flat.spawn" to also write the memory-mappable flat format
+SEGMENTATION_FILE = "segmentation.lzma" # or "segmentation.blocks" for datasets converted with bin/segblocks
+SHARED_POST_SEGMENTS = False # write .pb.spawn as version 3; only once every server reading the bucket loads version 3
 
 locks = {}
+session = None # spawner session of this worker process, see get_session
+
+def get_session():
+    """Created on first use, so every worker process gets its own threads after forking"""
+    global session
+    if session is None:
+        session = lib.SpawnSession_Create(c_uint(SPAWN_THREADS))
+        if session is None:
+            raise RuntimeError("Could not create the spawner session, see the log of the library")
+        lib.SpawnSession_SetSharedPosts(session, c_uint(SHARED_POST_SEGMENTS))
+    return session
 logging.basicConfig(filename='spawn.log',level=logging.DEBUG)
 
 def retry_if_backend_error(exception):
@@ -48,7 +78,7 @@ def unlzma(data):
     data = data[0:5] + data[13:]      #pylzma ignores 8 byte for length starting at 5th byte
     return pylzma.decompress(data)
 
-def retrieve_file(bucket, path, filename):
+def retrieve_file(bucket, path, filename, decompress=True):
     tmpdirname = "{}{}{}".format(TMPDIR, path, filename)
     (basename, ext) = os.path.splitext(filename)
 
@@ -60,7 +90,7 @@ def retrieve_file(bucket, path, filename):
         with open(tmpdirname, mode="rb") as f:
             response = f.read()
             locks[tmpdirname].release()
-            if ext == ".lzma":
+            if ext == ".lzma" and decompress:
                 response = unlzma(response)
             return response
 
@@ -73,7 +103,7 @@ def retrieve_file(bucket, path, filename):
         f.write(response)
     locks[tmpdirname].release()
 
-    if ext == ".lzma":
+    if ext == ".lzma" and decompress:
         response = unlzma(response)
 
     return response
@@ -88,12 +118,12 @@ def calcSpawnTable(bucket, pre_path, post_path):
         #print("Writing {}{}.pb.spawn".format(pre_path, post_chunk))
 
         pre_meta = retrieve_file(bucket, pre_path, "metadata.json")
-        pre_seg = retrieve_file(bucket, pre_path, "segmentation.lzma")
+        pre_seg = retrieve_file(bucket, pre_path, SEGMENTATION_FILE, decompress=False) # decoded by the library
         pre_sizes = retrieve_file(bucket, pre_path, "segmentation.size")
         pre_boxes = retrieve_file(bucket, pre_path, "segmentation.bbox")
 
         post_meta = retrieve_file(bucket, post_path, "metadata.json")
-        post_seg = retrieve_file(bucket, post_path, "segmentation.lzma")
+        post_seg = retrieve_file(bucket, post_path, SEGMENTATION_FILE, decompress=False)
         post_sizes = retrieve_file(bucket, post_path, "segmentation.size")
         post_boxes = retrieve_file(bucket, post_path, "segmentation.bbox")
 
@@ -107,14 +137,51 @@ def calcSpawnTable(bucket, pre_path, post_path):
         pre_volume  = InputVolume(c_char_p(pre_meta), pre_boxes_len, cast(c_char_p(pre_boxes), c_void_p), pre_sizes_len, cast(c_char_p(pre_sizes), c_void_p), pre_seg_len, cast(c_char_p(pre_seg), c_void_p))
         post_volume  = InputVolume(c_char_p(post_meta), post_boxes_len, cast(c_char_p(post_boxes), c_void_p), post_sizes_len, cast(c_char_p(post_sizes), c_void_p), post_seg_len, cast(c_char_p(post_seg), c_void_p))
 
-        result_p = cast(lib.SpawnSet_Generate(pointer(pre_volume), pointer(post_volume)), PSpawnTableWrapper)
+        gcloud_bucket = storage.bucket.Bucket(storage_client, bucket)
+        for spawn_format in SPAWN_TABLE_FORMATS:
+            result_p = lib.SpawnSession_Generate(get_session(), pointer(pre_volume), pointer(post_volume), c_uint(spawn_format == ".flat.spawn"), c_uint(1))
+            if not result_p:
+                raise RuntimeError("Spawn table generation failed, see the log of the library")
 
-        buffer = (c_char * result_p.contents.spawntableLength).from_address(result_p.contents.spawntableBuffer)
+            buffer = (c_char * result_p.contents.spawntableLength).from_address(result_p.contents.spawntableBuffer)
 
-        gcloud_bucket = storage.bucket.Bucket(storage_client, bucket)
-        gcloud_blob = storage.blob.Blob("{}{}.pb.spawn".format(pre_path, post_chunk), gcloud_bucket)
-        gcloud_blob.upload_from_string(buffer, content_type="application/octet-stream", client=storage_client)
+            gcloud_blob = storage.blob.Blob("{}{}{}".format(pre_path, post_chunk, spawn_format), gcloud_bucket)
+            gcloud_blob.upload_from_string(buffer, content_type="application/octet-stream", client=storage_client)
 
-        lib.SpawnSet_Release(result_p)
+            lib.SpawnSet_Release(result_p)
     except Exception:
         logging.error("{}{}.pb.spawn".format(pre_path, post_chunk), exc_info=True)
+
+def load_volume(bucket, path):
+    meta = retrieve_file(bucket, path, "metadata.json")
+    seg = retrieve_file(bucket, path, SEGMENTATION_FILE, decompress=False) # decoded by the library
+    sizes = retrieve_file(bucket, path, "segmentation.size")
+    boxes = retrieve_file(bucket, path, "segmentation.bbox")
+
+    volume = InputVolume(c_char_p(meta), len(boxes), cast(c_char_p(boxes), c_void_p), len(sizes), cast(c_char_p(sizes), c_void_p), len(seg), cast(c_char_p(seg), c_void_p))
+    return volume, (meta, seg, sizes, boxes) # the volume only points to the data, keep it alive with it
+
+def calcSpawnTables(bucket, center_path, neighbor_paths):
+    """Spawn tables of one center chunk towards all its neighbors, loading the center only once"""
+    try:
+        center_volume, center_data = load_volume(bucket, center_path)
+        neighbors = [load_volume(bucket, neighbor_path) for neighbor_path in neighbor_paths]
+        neighbor_volumes = (InputVolume * len(neighbors))(*[volume for volume, data in neighbors])
+
+        gcloud_bucket = storage.bucket.Bucket(storage_client, bucket)
+        for spawn_format in SPAWN_TABLE_FORMATS:
+            batch_p = lib.SpawnSession_GenerateFaces(get_session(), pointer(center_volume), neighbor_volumes, c_uint(len(neighbors)), c_uint(spawn_format == ".flat.spawn"), c_uint(1))
+            if not batch_p:
+                raise RuntimeError("Spawn table generation failed, see the log of the library")
+
+            for i, neighbor_path in enumerate(neighbor_paths):
+                post_chunk = os.path.basename(os.path.normpath(neighbor_path))
+                table = batch_p.contents.tables[i]
+                buffer = (c_char * table.spawntableLength).from_address(table.spawntableBuffer)
+
+                gcloud_blob = storage.blob.Blob("{}{}{}".format(center_path, post_chunk, spawn_format), gcloud_bucket)
+                gcloud_blob.upload_from_string(buffer, content_type="application/octet-stream", client=storage_client)
+
+            lib.SpawnSet_ReleaseFaces(batch_p)
+    except Exception:
+        logging.error("{}: {}".format(center_path, neighbor_paths), exc_info=True)